@@ -0,0 +1,92 @@
+#include "generators.h"
+#include <random>
+
+vector<Edge> random_graph_edges(int numVertices, int numEdges, int maxWeight, uint32_t seed)
+{
+    mt19937 rng(seed);
+    uniform_int_distribution<int> vertex(0, numVertices - 1), weight(1, maxWeight);
+    vector<Edge> edges;
+    edges.reserve(numEdges);
+    for (int i = 0; i < numEdges; ++i)
+        edges.emplace_back(vertex(rng), vertex(rng), weight(rng));
+    return edges;
+}
+
+vector<Edge> grid_graph_edges(int rows, int cols, int maxWeight, uint32_t seed)
+{
+    mt19937 rng(seed);
+    uniform_int_distribution<int> weight(1, maxWeight);
+    vector<Edge> edges;
+    auto link = [&](int u, int v) {
+        int w = weight(rng);
+        edges.emplace_back(u, v, w);
+        edges.emplace_back(v, u, w);
+    };
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            int u = r * cols + c;
+            if (c + 1 < cols) link(u, u + 1);
+            if (r + 1 < rows) link(u, u + cols);
+        }
+    }
+    return edges;
+}
+
+vector<Edge> power_law_graph_edges(int numVertices, int edgesPerVertex, int maxWeight, uint32_t seed)
+{
+    mt19937 rng(seed);
+    uniform_int_distribution<int> weight(1, maxWeight);
+    vector<Edge> edges;
+    vector<int> endpoints; // each vertex appears once per incident edge
+    for (int v = 0; v < numVertices; ++v) {
+        // draw only from earlier vertices' entries, so v never links to itself
+        size_t earlier = endpoints.size();
+        for (int k = 0; k < edgesPerVertex && earlier > 0; ++k) {
+            int u = endpoints[uniform_int_distribution<size_t>(0, earlier - 1)(rng)];
+            int w = weight(rng);
+            edges.emplace_back(v, u, w);
+            edges.emplace_back(u, v, w);
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+        if (endpoints.empty()) endpoints.push_back(v);
+    }
+    return edges;
+}
+
+void write_edge_list(const string& filename, int numVertices, const vector<Edge>& edges)
+{
+    ofstream out(filename);
+    if (!out)
+        throw runtime_error("Can't open output file");
+    out << numVertices << '\n';
+    for (const Edge& e : edges)
+        out << e.src << ' ' << e.dst << ' ' << e.weight << '\n';
+}
+
+vector<pair<string, string>> random_ladder_pairs(const Dictionary& dict, int count, uint32_t seed)
+{
+    mt19937 rng(seed);
+    uniform_int_distribution<int> word(0, dict.size() - 1);
+    vector<pair<string, string>> pairs;
+    for (int i = 0; i < count; ++i)
+        pairs.emplace_back(dict.word(word(rng)), dict.word(word(rng)));
+    return pairs;
+}
+
+vector<pair<string, string>> reachable_ladder_pairs(const WordIndex& index, int count, int steps, uint32_t seed)
+{
+    mt19937 rng(seed);
+    uniform_int_distribution<int> word(0, index.size() - 1);
+    vector<pair<string, string>> pairs;
+    for (int attempt = 0; static_cast<int>(pairs.size()) < count && attempt < 100 * count; ++attempt) {
+        int begin = word(rng), end = begin;
+        for (int s = 0; s < steps && !index.neighbors(end).empty(); ++s) {
+            span<const int> next = index.neighbors(end);
+            end = next[uniform_int_distribution<size_t>(0, next.size() - 1)(rng)];
+        }
+        if (end != begin)
+            pairs.emplace_back(index.dict.word(begin), index.dict.word(end));
+    }
+    return pairs;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "csr_graph.h"
+#include "ladder_index.h"
+#include <cstdint>
+
+// Synthetic workloads for the benchmarks. Every generator is deterministic
+// for a given seed; weights are uniform in [1, maxWeight].
+
+// numEdges directed edges between uniformly random endpoints.
+vector<Edge> random_graph_edges(int numVertices, int numEdges, int maxWeight, uint32_t seed);
+
+// rows x cols grid with edges both ways between 4-neighbors, like a road map.
+vector<Edge> grid_graph_edges(int rows, int cols, int maxWeight, uint32_t seed);
+
+// Preferential attachment: each new vertex links both ways to edgesPerVertex
+// existing vertices picked proportionally to degree, giving a power-law tail.
+vector<Edge> power_law_graph_edges(int numVertices, int edgesPerVertex, int maxWeight, uint32_t seed);
+
+// Writes the text format read by file_to_graph.
+void write_edge_list(const string& filename, int numVertices, const vector<Edge>& edges);
+
+// Uniformly sampled dictionary words; most such pairs have no ladder.
+vector<pair<string, string>> random_ladder_pairs(const Dictionary& dict, int count, uint32_t seed);
+
+// Pairs joined by a random walk of up to `steps` words, so a ladder exists.
+// Returns fewer than count pairs only if almost no word has a neighbor.
+vector<pair<string, string>> reachable_ladder_pairs(const WordIndex& index, int count, int steps, uint32_t seed);
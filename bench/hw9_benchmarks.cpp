@@ -0,0 +1,310 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <map>
+#include <random>
+#include <sys/resource.h>
+
+#include "contraction_hierarchy.h"
+#include "dijkstra_engine.h"
+#include "dijkstra_heaps.h"
+#include "edit_distance_batch.h"
+#include "generators.h"
+#include "graph_io.h"
+#include "ladder_index.h"
+#include "ladder_oracle.h"
+#include "point_to_point.h"
+
+// Graph families, selected by the first benchmark argument.
+enum GraphKind { RANDOM, GRID, POWER_LAW };
+
+namespace {
+
+const char* kind_name(int kind)
+{
+    return kind == RANDOM ? "random" : kind == GRID ? "grid" : "power_law";
+}
+
+// Roughly numVertices vertices and 4 * numVertices edges of the given family.
+struct Workload {
+    int numVertices;
+    vector<Edge> edges;
+    CSRGraph csr;
+    Graph lists;
+};
+
+const Workload& workload(int kind, int numVertices)
+{
+    static map<pair<int, int>, Workload> cache;
+    auto [it, fresh] = cache.try_emplace({kind, numVertices});
+    Workload& w = it->second;
+    if (fresh) {
+        int side = sqrt(numVertices);
+        w.numVertices = kind == GRID ? side * side : numVertices;
+        w.edges = kind == RANDOM ? random_graph_edges(numVertices, 4 * numVertices, 1000, 46)
+                : kind == GRID ? grid_graph_edges(side, side, 1000, 46)
+                : power_law_graph_edges(numVertices, 2, 1000, 46);
+        build_csr_graph(w.numVertices, w.edges, w.csr);
+        w.lists.numVertices = w.numVertices;
+        w.lists.resize(w.numVertices);
+        for (const Edge& e : w.edges) w.lists[e.src].push_back(e);
+    }
+    return w;
+}
+
+struct Words {
+    WordIndex index;
+    LadderOracle oracle;
+    vector<pair<string, string>> reachable;
+    vector<pair<string, string>> random;
+};
+
+const Words& words()
+{
+    static Words w = [] {
+        Words w;
+        Dictionary dict;
+        load_words(dict, HW9_DATA_DIR "/words.txt");
+        build_word_index(move(dict), w.index);
+        build_ladder_oracle(w.index, w.oracle);
+        w.reachable = reachable_ladder_pairs(w.index, 64, 12, 46);
+        w.random = random_ladder_pairs(w.index.dict, 64, 46);
+        return w;
+    }();
+    return w;
+}
+
+void report_graph(benchmark::State& state, const Workload& w)
+{
+    state.SetLabel(kind_name(state.range(0)));
+    state.counters["vertices"] = w.numVertices;
+    state.counters["edges"] = w.edges.size();
+    state.counters["csr_bytes"] = w.csr.offsets.size() * sizeof(int) + w.csr.arcs.size() * sizeof(Arc);
+}
+
+void report_peak_rss(benchmark::State& state)
+{
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    state.counters["peak_rss_kb"] = usage.ru_maxrss;
+}
+
+void graph_args(benchmark::internal::Benchmark* b)
+{
+    for (int kind : {RANDOM, GRID, POWER_LAW})
+        for (int n : {1 << 12, 1 << 16})
+            b->Args({kind, n});
+}
+
+}
+
+
+// ---- Dijkstra ----
+
+void BM_DijkstraAdjacencyLists(benchmark::State& state)
+{
+    const Workload& w = workload(state.range(0), state.range(1));
+    vector<int> previous;
+    int source = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dijkstra_shortest_path(w.lists, source, previous));
+        source = (source + 7919) % w.numVertices;
+    }
+    report_graph(state, w);
+}
+BENCHMARK(BM_DijkstraAdjacencyLists)->Apply(graph_args)->Unit(benchmark::kMillisecond);
+
+template <class Heap>
+void BM_DijkstraCSR(benchmark::State& state)
+{
+    const Workload& w = workload(state.range(0), state.range(1));
+    vector<int> previous;
+    int source = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dijkstra_shortest_path<Heap>(w.csr, source, previous));
+        source = (source + 7919) % w.numVertices;
+    }
+    report_graph(state, w);
+}
+BENCHMARK(BM_DijkstraCSR<LazyBinaryHeap>)->Apply(graph_args)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DijkstraCSR<FourAryHeap>)->Apply(graph_args)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DijkstraCSR<RadixHeap>)->Apply(graph_args)->Unit(benchmark::kMillisecond);
+
+// range(2): 0 = early-exit Dijkstra, 1 = bidirectional
+void BM_PointToPoint(benchmark::State& state)
+{
+    const Workload& w = workload(state.range(0), state.range(1));
+    BidirectionalGraph both;
+    build_bidirectional_graph(w.csr, both);
+    mt19937 rng(46);
+    uniform_int_distribution<int> vertex(0, w.numVertices - 1);
+    vector<int> path;
+    for (auto _ : state) {
+        int s = vertex(rng), t = vertex(rng);
+        benchmark::DoNotOptimize(state.range(2) == 0 ? dijkstra_point_to_point(w.csr, s, t, path)
+                                                     : bidirectional_dijkstra(both, s, t, path));
+    }
+    report_graph(state, w);
+}
+BENCHMARK(BM_PointToPoint)->ArgsProduct({{RANDOM, GRID, POWER_LAW}, {1 << 16}, {0, 1}})->Unit(benchmark::kMicrosecond);
+
+// Same random pairs as BM_PointToPoint; preprocessing is outside the timed loop.
+void BM_ContractionHierarchy(benchmark::State& state)
+{
+    const Workload& w = workload(state.range(0), state.range(1));
+    ContractionHierarchy ch;
+    build_contraction_hierarchy(w.csr, ch);
+    mt19937 rng(46);
+    uniform_int_distribution<int> vertex(0, w.numVertices - 1);
+    vector<int> path;
+    for (auto _ : state) {
+        int s = vertex(rng), t = vertex(rng);
+        benchmark::DoNotOptimize(ch_shortest_path(ch, s, t, path));
+    }
+    report_graph(state, w);
+    state.counters["hierarchy_arcs"] = ch.up.size() + ch.down.size();
+}
+BENCHMARK(BM_ContractionHierarchy)->Args({GRID, 1 << 16})->Unit(benchmark::kMicrosecond);
+
+// range(2): worker threads for a batch of 64 full single-source queries
+void BM_QueryEngine(benchmark::State& state)
+{
+    const Workload& w = workload(state.range(0), state.range(1));
+    vector<DijkstraQuery> queries;
+    for (int i = 0; i < 64; ++i) queries.push_back({(i * 7919) % w.numVertices, {}});
+    for (auto _ : state)
+        benchmark::DoNotOptimize(run_dijkstra_queries(w.csr, queries, state.range(2)));
+    report_graph(state, w);
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_QueryEngine)->ArgsProduct({{GRID}, {1 << 16}, {1, 2, 4}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+
+// ---- Loaders ----
+
+// range(2): 0 = istream Graph, 1 = istream CSRGraph, 2 = mmap text, 3 = open binary
+void BM_LoadGraph(benchmark::State& state)
+{
+    const Workload& w = workload(state.range(0), state.range(1));
+    const string text_file = "hw9_bench_graph.txt", binary_file = "hw9_bench_graph.csr";
+    write_edge_list(text_file, w.numVertices, w.edges);
+    save_binary_graph(w.csr, binary_file);
+
+    for (auto _ : state) {
+        switch (state.range(2)) {
+        case 0: { Graph g; file_to_graph(text_file, g); benchmark::DoNotOptimize(g.data()); break; }
+        case 1: { CSRGraph g; file_to_graph(text_file, g); benchmark::DoNotOptimize(g.arcs.data()); break; }
+        case 2: { CSRGraph g; mmap_file_to_graph(text_file, g); benchmark::DoNotOptimize(g.arcs.data()); break; }
+        default: { MappedGraph g(binary_file); benchmark::DoNotOptimize(g.neighbors(0).data()); break; }
+        }
+    }
+    remove(text_file.c_str());
+    remove(binary_file.c_str());
+    report_graph(state, w);
+    report_peak_rss(state);
+}
+BENCHMARK(BM_LoadGraph)->ArgsProduct({{RANDOM}, {1 << 16}, {0, 1, 2, 3}})->Unit(benchmark::kMillisecond);
+
+
+// ---- Word ladder ----
+
+void BM_BuildWordIndex(benchmark::State& state)
+{
+    Dictionary dict;
+    load_words(dict, HW9_DATA_DIR "/words.txt");
+    for (auto _ : state) {
+        WordIndex index;
+        build_word_index(dict, index);
+        benchmark::DoNotOptimize(index.adj.data());
+    }
+    state.counters["words"] = dict.size();
+    report_peak_rss(state);
+}
+BENCHMARK(BM_BuildWordIndex)->Unit(benchmark::kMillisecond);
+
+void BM_BuildLadderOracle(benchmark::State& state)
+{
+    const Words& w = words();
+    for (auto _ : state) {
+        LadderOracle oracle;
+        build_ladder_oracle(w.index, oracle);
+        benchmark::DoNotOptimize(oracle.distances.data());
+    }
+    state.counters["components"] = w.oracle.numComponents;
+}
+BENCHMARK(BM_BuildLadderOracle)->Unit(benchmark::kMillisecond);
+
+// range(0): 0 = forward, 1 = bidirectional, 2 = with the oracle; range(1): 0 = reachable pairs, 1 = random pairs
+void BM_GenerateWordLadder(benchmark::State& state)
+{
+    const Words& w = words();
+    const auto& pairs = state.range(1) == 0 ? w.reachable : w.random;
+    LadderSearch mode = state.range(0) == 0 ? LadderSearch::Forward : LadderSearch::Bidirectional;
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& [begin, end] = pairs[i++ % pairs.size()];
+        if (state.range(0) == 2)
+            benchmark::DoNotOptimize(generate_word_ladder(begin, end, w.index, w.oracle));
+        else
+            benchmark::DoNotOptimize(generate_word_ladder(begin, end, w.index, mode));
+    }
+    const char* names[] = {"forward", "bidirectional", "oracle"};
+    state.SetLabel(string(names[state.range(0)]) + (state.range(1) == 0 ? "/reachable" : "/random"));
+}
+BENCHMARK(BM_GenerateWordLadder)->ArgsProduct({{0, 1, 2}, {0, 1}})->Unit(benchmark::kMicrosecond);
+
+
+// ---- Edit distance ----
+
+// range(0): d
+void BM_EditDistanceWithin(benchmark::State& state)
+{
+    const Words& w = words();
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& [a, b] = w.reachable[i++ % w.reachable.size()];
+        benchmark::DoNotOptimize(edit_distance_within(a, b, state.range(0)));
+    }
+}
+BENCHMARK(BM_EditDistanceWithin)->Arg(1)->Arg(2);
+
+// range(0): 0 = scalar, 1 = sse2, 2 = avx2; range(1): d
+void BM_WordsWithin(benchmark::State& state)
+{
+    const char* kernels[] = {"scalar", "sse2", "avx2"};
+    string original = edit_distance_kernel();
+    if (!use_edit_distance_kernel(kernels[state.range(0)])) {
+        state.SkipWithError("kernel not supported on this CPU");
+        return;
+    }
+    const Words& w = words();
+    WordColumns columns;
+    build_word_columns(w.index.dict, columns);
+    size_t i = 0;
+    for (auto _ : state) {
+        const string& query = w.reachable[i++ % w.reachable.size()].first;
+        benchmark::DoNotOptimize(words_within(w.index.dict, query, state.range(1), &columns));
+    }
+    use_edit_distance_kernel(original);
+    state.SetLabel(kernels[state.range(0)]);
+}
+BENCHMARK(BM_WordsWithin)->ArgsProduct({{0, 1, 2}, {1, 2}})->Unit(benchmark::kMicrosecond);
+
+
+// JSON on stdout unless the caller picks another format.
+int main(int argc, char** argv)
+{
+    vector<char*> args(argv, argv + argc);
+    char json[] = "--benchmark_format=json";
+    bool has_format = false;
+    for (char* arg : args)
+        has_format |= string(arg).starts_with("--benchmark_format");
+    if (!has_format) args.push_back(json);
+
+    int count = args.size();
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -1,7 +1,56 @@
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <random>
+#include <thread>
+
+#include "contraction_hierarchy.h"
+#include "csr_graph.h"
+#include "dijkstra_engine.h"
+#include "dijkstra_heaps.h"
 #include "dijkstras.h"
+#include "graph_io.h"
 #include "ladder.h"
+#include "dictionary.h"
+#include "edit_distance_batch.h"
+#include "ladder_index.h"
+#include "ladder_oracle.h"
+#include "point_to_point.h"
+#include "search_stats.h"
+#include "sssp_cache.h"
+
+namespace {
+
+// numEdges random edges over n vertices, weights in [0, maxWeight); loops
+// and parallel edges included.
+vector<Edge> random_edges(mt19937& rng, int n, int numEdges, int maxWeight) {
+  vector<Edge> edges;
+  for (int i = 0; i < numEdges; ++i) edges.emplace_back(rng() % n, rng() % n, rng() % maxWeight);
+  return edges;
+}
+
+CSRGraph random_csr_graph(mt19937& rng, int n, int numEdges, int maxWeight) {
+  CSRGraph csr;
+  build_csr_graph(n, random_edges(rng, n, numEdges, maxWeight), csr);
+  return csr;
+}
+
+// Cost of walking path with the cheapest edge for every hop; INF if a hop has no edge.
+template <class G>
+int path_cost(const G& g, const vector<int>& path) {
+  int total = 0;
+  for (size_t i = 1; i < path.size(); ++i) {
+    int best = INF;
+    for (const auto& e : out_edges(g, path[i - 1]))
+      if (e.dst == path[i]) best = min(best, e.weight);
+    if (best == INF) return INF;
+    total += best;
+  }
+  return total;
+}
+
+}
+
 
 TEST(EditDistance, Test) {
   EXPECT_FALSE(is_adjacent("Bailey", "psychic"));
@@ -21,4 +70,494 @@ TEST(WordLadder, Test) {
   string end = "applying";
   vector<string> expect = {"apple", "apply", "applyi", "applyin", "applying"};
   EXPECT_EQ(generate_word_ladder(begin, end, word_list), expect);
-}
\ No newline at end of file
+}
+
+TEST(WordIndex, Neighbors) {
+  set<string> word_list = {"cat", "cot", "coat", "at", "dog", "cart", "scat"};
+  WordIndex index;
+  build_word_index(word_list, index);
+  vector<string> got;
+  for (int id : index.neighbors(index.find("cat"))) got.push_back(string(index.dict.word(id)));
+  vector<string> expect = {"at", "cart", "coat", "cot", "scat"};
+  EXPECT_EQ(got, expect);
+  EXPECT_TRUE(index.neighbors(index.find("dog")).empty());
+  EXPECT_EQ(adjacent_words(index, "bat").size(), 2u); // "at", "cat"
+}
+
+
+TEST(WordLadder, BidirectionalMatchesForward) {
+  set<string> word_list = {"cat", "cot", "cog", "dog", "bat", "bag", "bog", "dot", "hot", "hog"};
+  WordIndex index;
+  build_word_index(word_list, index);
+  for (const char* end : {"dog", "hog", "bag", "cat"}) {
+    vector<string> forward = generate_word_ladder("cat", end, index, LadderSearch::Forward);
+    vector<string> both = generate_word_ladder("cat", end, index, LadderSearch::Bidirectional);
+    EXPECT_EQ(forward.size(), both.size()) << end;
+    for (size_t i = 1; i < both.size(); ++i) EXPECT_TRUE(is_adjacent(both[i - 1], both[i]));
+  }
+  vector<string> expect = {"cut", "cot", "dot", "dog"};
+  EXPECT_EQ(generate_word_ladder("cut", "dog", index).size(), expect.size());
+  EXPECT_TRUE(generate_word_ladder("cat", "zebra", index).empty());
+}
+
+
+TEST(Dictionary, Lookup) {
+  Dictionary dict;
+  build_dictionary(set<string>{"pear", "apple", "fig", "banana"}, dict);
+  ASSERT_EQ(dict.size(), 4);
+  EXPECT_EQ(dict.word(0), "apple");
+  EXPECT_EQ(dict.word(3), "pear");
+  EXPECT_EQ(dict.find("fig"), 2);
+  EXPECT_EQ(dict.find("figs"), -1);
+  EXPECT_EQ(dict.find(""), -1);
+  EXPECT_EQ(generate_word_ladder("fig", "pear", dict).size(), 0u);
+}
+
+
+TEST(EditDistance, WithinTwo) {
+  EXPECT_TRUE(edit_distance_within("abcd", "bcda", 2));
+  EXPECT_FALSE(edit_distance_within("abcd", "bcda", 1));
+  EXPECT_TRUE(edit_distance_within("kitten", "sitting", 3));
+  EXPECT_FALSE(edit_distance_within("kitten", "sitting", 2));
+  EXPECT_TRUE(edit_distance_within("at", "cart", 2));
+  EXPECT_FALSE(edit_distance_within("at", "dog", 2));
+}
+
+
+TEST(EditDistance, BatchMatchesScalar) {
+  set<string> word_list = {"a", "at", "bat", "cat", "coat", "cart", "scat", "bcda", "abcd", "kitten",
+                           "sitting", "abcdefghijklmnopqrstuvwxyz0123456789", "abcdefghijklmnopqrstuvwxyz012345678",
+                           string(70, 'a'), string(69, 'a') + "b"};
+  // enough short words to fill several lane blocks per length
+  mt19937 rng(4);
+  for (int i = 0; i < 300; ++i) {
+    string w(2 + rng() % 5, 'a');
+    for (char& c : w) c = "abct"[rng() % 4];
+    word_list.insert(w);
+  }
+  Dictionary dict;
+  build_dictionary(word_list, dict);
+  vector<int> all(dict.size());
+  for (int i = 0; i < dict.size(); ++i) all[i] = i;
+  WordColumns columns;
+  build_word_columns(dict, columns);
+
+  string original = edit_distance_kernel();
+  for (const char* kernel : {"scalar", "sse2", "avx2"}) {
+    if (!use_edit_distance_kernel(kernel)) continue;
+    for (const string& query : vector<string>{"cat", "abcd", "sitten", "abcdefghijklmnopqrstuvwxyz0123456789", "x", "tacab", string(68, 'a')}) {
+      for (int d : {0, 1, 2, 3, 17}) {
+        vector<uint64_t> mask = edit_distance_within_batch(dict, query, all, d);
+        vector<int> expect;
+        for (int i = 0; i < dict.size(); ++i) {
+          bool want = levenshtein_within(query, dict.word(i), d);
+          EXPECT_EQ(((mask[i / 64] >> (i % 64)) & 1) != 0, want) << kernel << " " << query << " " << dict.word(i) << " " << d;
+          if (want) expect.push_back(i);
+        }
+        EXPECT_EQ(words_within(dict, query, d), expect) << kernel;
+        EXPECT_EQ(words_within(dict, query, d, &columns), expect) << kernel;
+      }
+    }
+  }
+  use_edit_distance_kernel(original);
+}
+
+
+TEST(CSRGraph, MatchesAdjacencyLists) {
+  const string text = "6\n0 1 7\n0 2 9\n0 5 14\n1 2 10\n1 3 15\n2 3 11\n2 5 2\n3 4 6\n5 4 9\n4 0 1\n";
+  Graph g;
+  istringstream(text) >> g;
+  CSRGraph csr;
+  istringstream(text) >> csr;
+  ASSERT_EQ(csr.numVertices, 6);
+  ASSERT_EQ(csr.arcs.size(), 10u);
+  EXPECT_EQ(csr.neighbors(0).size(), 3u);
+  EXPECT_EQ(csr.neighbors(2)[1].dst, 5);
+
+  vector<int> prev_list, prev_csr;
+  vector<int> expect = dijkstra_shortest_path(g, 0, prev_list);
+  EXPECT_EQ(dijkstra_shortest_path(csr, 0, prev_csr), expect);
+  EXPECT_EQ(extract_shortest_path(expect, prev_csr, 4), (vector<int>{0, 2, 5, 4}));
+
+  istringstream bad("2\n0 5 1\n");
+  EXPECT_THROW(bad >> csr, runtime_error);
+}
+
+
+TEST(DijkstraHeaps, AllHeapsAgree) {
+  mt19937 rng(46);
+  const int n = 300;
+  vector<Edge> edges = random_edges(rng, n, 3000, 1000);
+  CSRGraph csr;
+  build_csr_graph(n, edges, csr);
+  Graph g;
+  g.numVertices = n;
+  g.resize(n);
+  for (const Edge& e : edges) g[e.src].push_back(e);
+
+  for (int source : {0, 17, 299}) {
+    vector<int> previous;
+    vector<int> expect = dijkstra_shortest_path(g, source, previous);
+    EXPECT_EQ(dijkstra_shortest_path<LazyBinaryHeap>(csr, source, previous), expect);
+    EXPECT_EQ(dijkstra_shortest_path<FourAryHeap>(g, source, previous), expect);
+    EXPECT_EQ(dijkstra_shortest_path<IndexedDaryHeap<2>>(csr, source, previous), expect);
+    EXPECT_EQ(dijkstra_shortest_path<RadixHeap>(csr, source, previous), expect);
+    for (int v = 0; v < n; ++v)
+      if (previous[v] >= 0) {
+        EXPECT_LE(expect[previous[v]], expect[v]);
+      }
+  }
+}
+
+
+TEST(DijkstraHeaps, DecreaseKey) {
+  FourAryHeap four;
+  RadixHeap radix;
+  four.reset(5);
+  radix.reset(5);
+  for (int v = 0; v < 5; ++v) {
+    four.push(v, 100 - v);
+    radix.push(v, 100 - v);
+  }
+  four.push(0, 1);
+  radix.push(0, 1);
+  four.push(4, 200); // larger key is ignored
+  radix.push(4, 200);
+  EXPECT_EQ(four.size(), 5);
+  EXPECT_EQ(radix.size(), 5);
+  vector<int> order_four, order_radix;
+  while (!four.empty()) order_four.push_back(four.pop());
+  while (!radix.empty()) order_radix.push_back(radix.pop());
+  EXPECT_EQ(order_four, (vector<int>{0, 4, 3, 2, 1}));
+  EXPECT_EQ(order_radix, order_four);
+}
+
+
+TEST(DijkstraEngine, BatchMatchesSingleQueries) {
+  mt19937 rng(7);
+  const int n = 200;
+  CSRGraph csr = random_csr_graph(rng, n, 1000, 50);
+
+  vector<DijkstraQuery> queries;
+  for (int i = 0; i < 40; ++i) {
+    DijkstraQuery q{static_cast<int>(rng() % n), {}};
+    for (int k = i % 4; k > 0; --k) q.targets.push_back(rng() % n);
+    if (i % 4 == 3) q.targets.push_back(q.targets.front()); // duplicate target
+    queries.push_back(q);
+  }
+
+  for (int threads : {1, 3}) {
+    vector<DijkstraResult> results = run_dijkstra_queries(csr, queries, threads);
+    ASSERT_EQ(results.size(), queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+      vector<int> previous;
+      vector<int> all = dijkstra_shortest_path(csr, queries[i].source, previous);
+      if (queries[i].targets.empty()) {
+        EXPECT_EQ(results[i].distances, all);
+      } else {
+        for (size_t k = 0; k < queries[i].targets.size(); ++k)
+          EXPECT_EQ(results[i].distances[k], all[queries[i].targets[k]]);
+      }
+    }
+  }
+  EXPECT_THROW(run_dijkstra_queries(csr, {{n, {}}}), runtime_error);
+  csr.arcs.front().weight = -1;
+  EXPECT_THROW(run_dijkstra_queries(csr, {{0, {}}}), runtime_error);
+}
+
+
+TEST(PointToPoint, MatchesFullDijkstra) {
+  mt19937 rng(11);
+  const int n = 150;
+  CSRGraph csr = random_csr_graph(rng, n, 600, 100);
+  BidirectionalGraph both;
+  build_bidirectional_graph(csr, both);
+
+  for (int source : {0, 5, 77}) {
+    vector<int> previous;
+    vector<int> expect = dijkstra_shortest_path(csr, source, previous);
+    for (int target = 0; target < n; target += 7) {
+      // half the true remaining distance: admissible but far from exact
+      vector<int> to_target;
+      vector<int> remaining = dijkstra_shortest_path(both.backward, target, to_target);
+      auto half = [&](int v) { return remaining[v] == INF ? 0 : remaining[v] / 2; };
+
+      vector<int> paths[3];
+      EXPECT_EQ(dijkstra_point_to_point(csr, source, target, paths[0]), expect[target]);
+      EXPECT_EQ(bidirectional_dijkstra(both, source, target, paths[1]), expect[target]);
+      EXPECT_EQ(astar_shortest_path(csr, source, target, half, paths[2]), expect[target]);
+      for (const vector<int>& path : paths) {
+        if (expect[target] == INF) {
+          EXPECT_TRUE(path.empty());
+        } else {
+          EXPECT_EQ(path.front(), source);
+          EXPECT_EQ(path.back(), target);
+          EXPECT_EQ(path_cost(csr, path), expect[target]);
+        }
+      }
+    }
+  }
+}
+
+
+TEST(GraphIO, TextAndBinaryRoundTrip) {
+  mt19937 rng(9);
+  const int n = 120;
+  string text = to_string(n) + "\n";
+  for (int i = 0; i < 800; ++i)
+    text += to_string(rng() % n) + " " + to_string(rng() % n) + " " + to_string(rng() % 30) + "\n";
+  const string text_file = "graph_io_test.txt", binary_file = "graph_io_test.csr";
+  ofstream(text_file) << text;
+
+  CSRGraph expect;
+  istringstream(text) >> expect;
+  for (int threads : {1, 3, 4}) {
+    CSRGraph g;
+    mmap_file_to_graph(text_file, g, threads);
+    EXPECT_EQ(g.numVertices, expect.numVertices);
+    EXPECT_EQ(g.offsets, expect.offsets);
+    ASSERT_EQ(g.arcs.size(), expect.arcs.size());
+    for (size_t i = 0; i < g.arcs.size(); ++i) {
+      EXPECT_EQ(g.arcs[i].dst, expect.arcs[i].dst);
+      EXPECT_EQ(g.arcs[i].weight, expect.arcs[i].weight);
+    }
+  }
+
+  save_binary_graph(expect, binary_file);
+  {
+    MappedGraph mapped(binary_file);
+    ASSERT_EQ(mapped.numVertices, n);
+    vector<int> prev_mapped, prev_csr;
+    EXPECT_EQ(dijkstra_shortest_path<FourAryHeap>(mapped, 3, prev_mapped), dijkstra_shortest_path(expect, 3, prev_csr));
+    CSRGraph loaded;
+    load_binary_graph(binary_file, loaded);
+    EXPECT_EQ(loaded.offsets, expect.offsets);
+  }
+  {
+    // a row that ends past the last arc
+    fstream patch(binary_file, ios::in | ios::out | ios::binary);
+    patch.seekp(sizeof(GraphFileHeader) + sizeof(int32_t));
+    int32_t bad = expect.arcs.size() + 1;
+    patch.write(reinterpret_cast<const char*>(&bad), sizeof(bad));
+  }
+  EXPECT_THROW(MappedGraph{binary_file}, runtime_error);
+
+  EXPECT_THROW(MappedGraph{text_file}, runtime_error);
+  ofstream(text_file) << "3\n0 1 2\n1 x 2\n";
+  CSRGraph g;
+  EXPECT_THROW(mmap_file_to_graph(text_file, g), runtime_error);
+  remove(text_file.c_str());
+  remove(binary_file.c_str());
+}
+
+
+TEST(ShortestPathCache, RepairsMatchRecomputation) {
+  mt19937 rng(13);
+  const int n = 80;
+  Graph g;
+  g.numVertices = n;
+  g.resize(n);
+  for (const Edge& e : random_edges(rng, n, 320, 20)) g[e.src].push_back(e);
+  ShortestPathCache cache(g, 2);
+
+  for (int step = 0; step < 300; ++step) {
+    int u = rng() % n;
+    int op = rng() % 3;
+    if (op == 0 || g[u].empty()) {
+      int v = rng() % n, w = rng() % 20;
+      g[u].emplace_back(u, v, w);
+      cache.insert_edge(u, v, w);
+    } else {
+      int v = g[u][rng() % g[u].size()].dst;
+      auto first = find_if(g[u].begin(), g[u].end(), [v](const Edge& e) { return e.dst == v; });
+      if (op == 1) {
+        g[u].erase(first);
+        cache.remove_edge(u, v);
+      } else {
+        first->weight = rng() % 20;
+        cache.set_edge_weight(u, v, first->weight);
+      }
+    }
+
+    int source = step % 10 == 9 ? 2 : step % 2; // mostly cached trees, an occasional eviction
+    vector<int> previous;
+    vector<int> expect = dijkstra_shortest_path(g, source, previous);
+    ASSERT_EQ(cache.distances(source), expect) << "step " << step;
+    int target = rng() % n;
+    vector<int> path = cache.path(source, target);
+    if (expect[target] == INF) {
+      EXPECT_TRUE(path.empty());
+    } else {
+      EXPECT_EQ(path_cost(g, path), expect[target]);
+    }
+  }
+  EXPECT_EQ(cache.cached_sources(), 2);
+  EXPECT_THROW(cache.remove_edge(0, n), runtime_error);
+  EXPECT_THROW(cache.insert_edge(0, 1, -1), runtime_error);
+  cache.insert_edge(0, 1, 5);
+  EXPECT_THROW(cache.set_edge_weight(0, 1, -1), runtime_error);
+  EXPECT_LE(cache.distance(0, 1), 5);
+}
+
+
+TEST(ContractionHierarchy, MatchesDijkstra) {
+  mt19937 rng(17);
+  const int n = 150;
+  CSRGraph g = random_csr_graph(rng, n, 600, 25); // includes zero weights, loops and parallel edges
+
+  ContractionHierarchy built, ch;
+  build_contraction_hierarchy(g, built);
+  const string file = "contraction_hierarchy_test.ch";
+  save_contraction_hierarchy(built, file);
+  load_contraction_hierarchy(file, ch);
+  EXPECT_EQ(ch.rank, built.rank);
+
+  for (int source = 0; source < n; source += 7) {
+    vector<int> previous, path;
+    vector<int> expect = dijkstra_shortest_path(g, source, previous);
+    for (int target = 0; target < n; ++target) {
+      int d = ch_shortest_path(ch, source, target, path);
+      ASSERT_EQ(d, expect[target]) << source << " -> " << target;
+      if (d == INF) {
+        EXPECT_TRUE(path.empty());
+        continue;
+      }
+      ASSERT_EQ(path.front(), source);
+      ASSERT_EQ(path.back(), target);
+      EXPECT_EQ(path_cost(g, path), d);
+    }
+  }
+
+  vector<int> path;
+  EXPECT_THROW(ch_shortest_path(ch, 0, n, path), runtime_error);
+  ofstream(file) << "not a hierarchy";
+  EXPECT_THROW(load_contraction_hierarchy(file, ch), runtime_error);
+  remove(file.c_str());
+}
+
+
+TEST(LadderOracle, MatchesBreadthFirstSearch) {
+  mt19937 rng(21);
+  set<string> word_list;
+  for (int i = 0; i < 400; ++i) {
+    string word(2 + rng() % 3, 'a');
+    for (char& c : word) c = "abcdefg"[rng() % 7];
+    word_list.insert(word);
+  }
+  word_list.insert({"zzzz", "zzzy"}); // a component of their own
+  WordIndex index;
+  build_word_index(word_list, index);
+
+  LadderOracle built, oracle;
+  build_ladder_oracle(index, built, 4);
+  ASSERT_EQ(built.landmarks.size(), 4u);
+  const string file = "ladder_oracle_test.bin";
+  save_ladder_oracle(index, built, file);
+  load_ladder_oracle(file, index, oracle);
+  EXPECT_EQ(oracle.component, built.component);
+  EXPECT_EQ(oracle.distances, built.distances);
+  EXPECT_FALSE(oracle.connected(index.find("zzzz"), index.find(*word_list.begin())));
+
+  vector<string> words(word_list.begin(), word_list.end());
+  words.push_back("gggggg"); // not in the dictionary
+  for (int i = 0; i < 300; ++i) {
+    const string& begin = words[rng() % words.size()];
+    const string& end = words[rng() % (words.size() - 1)];
+    vector<string> expect = generate_word_ladder(begin, end, index, LadderSearch::Bidirectional);
+    vector<string> ladder = generate_word_ladder(begin, end, index, oracle);
+    ASSERT_EQ(ladder.size(), expect.size()) << begin << " -> " << end;
+    if (ladder.empty()) continue;
+    EXPECT_EQ(ladder.front(), begin);
+    EXPECT_EQ(ladder.back(), end);
+    for (size_t j = 1; j < ladder.size(); ++j) EXPECT_TRUE(is_adjacent(ladder[j - 1], ladder[j]));
+    int a = index.find(begin);
+    if (a >= 0) {
+      EXPECT_LE(oracle.lower_bound(a, index.find(end)), static_cast<int>(ladder.size()) - 1);
+    }
+  }
+  EXPECT_TRUE(generate_word_ladder("zzzz", *word_list.begin(), index, oracle).empty());
+
+  WordIndex other;
+  build_word_index(set<string>{"cat", "cot"}, other);
+  EXPECT_THROW(load_ladder_oracle(file, other, oracle), runtime_error);
+  remove(file.c_str());
+}
+
+
+TEST(SearchStats, CountsSearchWork) {
+#if !HW9_STATS
+  GTEST_SKIP() << "built with HW9_STATS=0";
+#endif
+  // 0 -> 1 -> 2 beats the direct 0 -> 2; 3 is unreachable
+  Graph g;
+  g.numVertices = 4;
+  g.resize(4);
+  g[0] = {Edge(0, 1, 1), Edge(0, 2, 5)};
+  g[1] = {Edge(1, 2, 1)};
+  CSRGraph csr;
+  graph_to_csr(g, csr);
+
+  reset_thread_search_stats();
+  int callbacks = 0;
+  set_search_stats_callback([&](SearchEngine engine, const SearchStats&) { callbacks += engine == SearchEngine::Dijkstra; });
+
+  SearchStats lists, indexed;
+  vector<int> previous;
+  dijkstra_shortest_path(g, 0, previous, &lists);
+  EXPECT_EQ(lists.vertices_settled, 3u);
+  EXPECT_EQ(lists.edges_relaxed, 3u);
+  EXPECT_EQ(lists.heap_pushes, 4u);
+  EXPECT_EQ(lists.stale_pops, 1u); // the 0 -> 2 entry left behind by the lazy heap
+  dijkstra_shortest_path(csr, 0, previous, &indexed);
+  EXPECT_EQ(indexed.vertices_settled, 3u);
+  EXPECT_EQ(indexed.stale_pops, 0u);
+  EXPECT_GT(indexed.bytes_allocated, 4 * 2 * sizeof(int)); // the heap's arrays count too
+  EXPECT_EQ(callbacks, 2);
+  EXPECT_EQ(thread_search_stats(SearchEngine::Dijkstra).queries, 2u);
+  EXPECT_EQ(thread_search_stats(SearchEngine::Dijkstra).vertices_settled, 6u);
+
+  WordIndex index;
+  build_word_index(set<string>{"cat", "cot", "cog", "dog", "bat"}, index);
+  SearchStats forward, both;
+  EXPECT_EQ(generate_word_ladder("cat", "dog", index, LadderSearch::Forward, &forward).size(), 4u);
+  EXPECT_GT(forward.vertices_settled, 0u);
+  EXPECT_GE(forward.queue_peak, 1u);
+  EXPECT_EQ(forward.adjacency_checks, 0u);
+  EXPECT_EQ(generate_word_ladder("cut", "dog", index, LadderSearch::Bidirectional, &both).size(), 4u);
+  EXPECT_EQ(both.adjacency_checks, 5u); // every word of length 2 to 4
+  EXPECT_EQ(thread_search_stats(SearchEngine::WordLadder).queries, 2u);
+
+  // other threads keep their own totals
+  thread([&] { dijkstra_shortest_path(csr, 0, previous); }).join();
+  EXPECT_EQ(thread_search_stats(SearchEngine::Dijkstra).queries, 2u);
+  EXPECT_EQ(callbacks, 3);
+
+  // point-to-point searches stop once 2 is popped, before expanding it
+  SearchStats p2p, both_ends, astar, ch_stats, scratch_stats;
+  vector<int> path;
+  EXPECT_EQ(dijkstra_point_to_point(csr, 0, 2, path, &p2p), 2);
+  EXPECT_EQ(p2p.vertices_settled, 2u);
+  EXPECT_EQ(p2p.edges_relaxed, 3u);
+  BidirectionalGraph bidirectional;
+  build_bidirectional_graph(csr, bidirectional);
+  EXPECT_EQ(bidirectional_dijkstra(bidirectional, 0, 2, path, &both_ends), 2);
+  EXPECT_GT(both_ends.vertices_settled, 0u);
+  EXPECT_EQ(astar_shortest_path(csr, 0, 2, [](int) { return 0; }, path, &astar), 2);
+  EXPECT_EQ(astar.vertices_settled, 2u);
+  ContractionHierarchy ch;
+  build_contraction_hierarchy(csr, ch);
+  EXPECT_EQ(ch_shortest_path(ch, 0, 2, path, &ch_stats), 2);
+  EXPECT_GT(ch_stats.heap_pushes, 0u);
+  EXPECT_EQ(callbacks, 7);
+
+  // reused scratch only counts what it had to grow by
+  DijkstraScratch scratch;
+  dijkstra_with_scratch(csr, 0, {}, scratch, &scratch_stats);
+  EXPECT_EQ(scratch_stats.vertices_settled, 3u);
+  EXPECT_GT(scratch_stats.bytes_allocated, 0u);
+  dijkstra_with_scratch(csr, 0, {}, scratch, &scratch_stats);
+  EXPECT_EQ(scratch_stats.bytes_allocated, 0u);
+  ch_shortest_path(ch, 0, 2, path, &ch_stats);
+  EXPECT_EQ(ch_stats.bytes_allocated, 0u);
+  set_search_stats_callback(nullptr);
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <fstream>
+#include <vector>
+
+using namespace std;
+
+// Raw arrays of the binary index files (native byte order, no length
+// prefix: the file header says how many elements follow).
+template <class T>
+void write_array(ofstream& out, const vector<T>& values)
+{
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+template <class T>
+void read_array(ifstream& in, vector<T>& values, size_t count)
+{
+    values.resize(count);
+    in.read(reinterpret_cast<char*>(values.data()), count * sizeof(T));
+}
@@ -0,0 +1,396 @@
+#include "contraction_hierarchy.h"
+#include "binary_io.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <queue>
+
+namespace {
+
+// Witness searches give up after settling this many vertices; a missed
+// witness only costs an unnecessary shortcut, never a wrong distance.
+constexpr int WITNESS_SETTLE_LIMIT = 500;
+
+// The overlay keeps one arc per (u, dst) pair, the cheapest seen so far.
+void add_arc(vector<CHArc>& row, int dst, int weight, int middle)
+{
+    for (CHArc& a : row) {
+        if (a.dst == dst) {
+            if (weight < a.weight) {
+                a.weight = weight;
+                a.middle = middle;
+            }
+            return;
+        }
+    }
+    row.push_back({dst, weight, middle});
+}
+
+void remove_arc(vector<CHArc>& row, int dst)
+{
+    auto it = find_if(row.begin(), row.end(), [dst](const CHArc& a) { return a.dst == dst; });
+    *it = row.back();
+    row.pop_back();
+}
+
+const CHArc& find_arc(span<const CHArc> row, int dst)
+{
+    return *find_if(row.begin(), row.end(), [dst](const CHArc& a) { return a.dst == dst; });
+}
+
+// Contracts vertices one at a time on an overlay of the not-yet-contracted graph.
+class Contractor {
+public:
+    explicit Contractor(const CSRGraph& G)
+        : numVertices(G.numVertices), out(G.numVertices), in(G.numVertices),
+          contracted(G.numVertices, false), contracted_neighbors(G.numVertices, 0),
+          distances(G.numVertices, INF), is_target(G.numVertices, false)
+    {
+        for (int u = 0; u < numVertices; ++u) {
+            for (const Arc& a : G.neighbors(u)) {
+                if (a.dst == u) continue;
+                add_arc(out[u], a.dst, a.weight, -1);
+                add_arc(in[a.dst], u, a.weight, -1);
+            }
+        }
+        pq.reset(numVertices);
+    }
+
+    void run(ContractionHierarchy& ch)
+    {
+        vector<vector<CHArc>> up_rows(numVertices), down_rows(numVertices);
+        ch.numVertices = numVertices;
+        ch.rank.assign(numVertices, -1);
+
+        // min-queue of (priority, vertex); entries that no longer match
+        // current[] are stale. Neighbours are re-scored after each contraction,
+        // and a popped vertex is re-scored once more before it is contracted.
+        vector<int> current(numVertices);
+        priority_queue<pair<int, int>, vector<pair<int, int>>, greater<>> order;
+        for (int v = 0; v < numVertices; ++v) {
+            current[v] = priority(v);
+            order.push({current[v], v});
+        }
+
+        int next_rank = 0;
+        vector<int> neighbors;
+        while (!order.empty()) {
+            auto [p, v] = order.top();
+            order.pop();
+            if (contracted[v] || p != current[v]) continue;
+            current[v] = priority(v);
+            if (current[v] > p) {
+                order.push({current[v], v});
+                continue;
+            }
+
+            // shortcuts still holds v's shortcuts from priority(v)
+            for (const auto& [u, arc] : shortcuts) {
+                add_arc(out[u], arc.dst, arc.weight, v);
+                add_arc(in[arc.dst], u, arc.weight, v);
+            }
+            neighbors.clear();
+            for (const CHArc& a : out[v]) {
+                remove_arc(in[a.dst], v);
+                neighbors.push_back(a.dst);
+            }
+            for (const CHArc& a : in[v]) {
+                remove_arc(out[a.dst], v);
+                neighbors.push_back(a.dst);
+            }
+            up_rows[v] = move(out[v]);
+            down_rows[v] = move(in[v]);
+            contracted[v] = true;
+            ch.rank[v] = next_rank++;
+
+            sort(neighbors.begin(), neighbors.end());
+            neighbors.erase(unique(neighbors.begin(), neighbors.end()), neighbors.end());
+            for (int x : neighbors) {
+                ++contracted_neighbors[x];
+                current[x] = priority(x);
+                order.push({current[x], x});
+            }
+        }
+
+        ch.up_offsets.assign(1, 0);
+        ch.down_offsets.assign(1, 0);
+        ch.up.clear();
+        ch.down.clear();
+        for (int v = 0; v < numVertices; ++v) {
+            ch.up.insert(ch.up.end(), up_rows[v].begin(), up_rows[v].end());
+            ch.up_offsets.push_back(ch.up.size());
+            ch.down.insert(ch.down.end(), down_rows[v].begin(), down_rows[v].end());
+            ch.down_offsets.push_back(ch.down.size());
+        }
+    }
+
+private:
+    // Edge difference, weighted double, plus contracted neighbours, which
+    // spreads the contraction evenly over the graph.
+    int priority(int v)
+    {
+        find_shortcuts(v);
+        int removed = out[v].size() + in[v].size();
+        return 2 * (static_cast<int>(shortcuts.size()) - removed) + contracted_neighbors[v];
+    }
+
+    // Fills shortcuts with every u -> v -> w path that has no witness
+    // u ~> w of at most the same length avoiding v.
+    void find_shortcuts(int v)
+    {
+        shortcuts.clear();
+        for (const CHArc& in_arc : in[v]) {
+            int u = in_arc.dst, limit = 0;
+            for (const CHArc& out_arc : out[v]) {
+                if (out_arc.dst == u) continue;
+                is_target[out_arc.dst] = true;
+                targets.push_back(out_arc.dst);
+                limit = max(limit, in_arc.weight + out_arc.weight);
+            }
+            if (targets.empty()) continue;
+
+            witness_search(u, v, limit);
+            for (const CHArc& out_arc : out[v]) {
+                int w = out_arc.dst, via = in_arc.weight + out_arc.weight;
+                if (w != u && distances[w] > via)
+                    shortcuts.push_back({u, {w, via, v}});
+            }
+            for (int x : touched) distances[x] = INF;
+            touched.clear();
+            for (int w : targets) is_target[w] = false;
+            targets.clear();
+        }
+    }
+
+    // Dijkstra from source that never enters skip, stopping once every
+    // target is settled, past limit, or after WITNESS_SETTLE_LIMIT vertices.
+    // Leaves tentative distances in distances/touched.
+    void witness_search(int source, int skip, int limit)
+    {
+        distances[source] = 0;
+        touched.push_back(source);
+        pq.push(source, 0);
+        int remaining = targets.size();
+        for (int settled = 0; !pq.empty() && pq.top_key() <= limit && settled < WITNESS_SETTLE_LIMIT; ++settled) {
+            int x = pq.pop();
+            if (is_target[x] && --remaining == 0) break;
+            for (const CHArc& a : out[x]) {
+                int d = distances[x] + a.weight;
+                if (a.dst != skip && d < distances[a.dst]) {
+                    if (distances[a.dst] == INF) touched.push_back(a.dst);
+                    distances[a.dst] = d;
+                    pq.push(a.dst, d);
+                }
+            }
+        }
+        pq.clear();
+    }
+
+    int numVertices;
+    vector<vector<CHArc>> out; // out[u]: overlay arcs u -> dst
+    vector<vector<CHArc>> in;  // in[v]: overlay arcs dst -> v
+    vector<bool> contracted;
+    vector<int> contracted_neighbors;
+    vector<pair<int, CHArc>> shortcuts; // (u, u -> w via v)
+
+    // witness search scratch
+    vector<int> distances;
+    vector<int> touched;
+    vector<int> targets;
+    vector<bool> is_target;
+    FourAryHeap pq;
+};
+
+// One direction of a query. Reset touches only the vertices the last query
+// reached, so repeated queries cost their search space, not numVertices.
+struct CHSearch {
+    vector<int> distances;
+    vector<int> parent;
+    vector<int> middle; // middle of the arc between a vertex and its parent
+    vector<int> touched;
+    FourAryHeap pq;
+
+    void prepare(int numVertices)
+    {
+        if (static_cast<int>(distances.size()) != numVertices) {
+            distances.assign(numVertices, INF);
+            parent.assign(numVertices, -1);
+            middle.assign(numVertices, -1);
+            pq.reset(numVertices);
+            touched.clear();
+        }
+        for (int v : touched) distances[v] = INF;
+        touched.clear();
+        pq.clear();
+    }
+
+    size_t bytes() const
+    {
+        return (distances.capacity() + parent.capacity() + middle.capacity() + touched.capacity()) * sizeof(int)
+               + pq.bytes();
+    }
+
+    void reach(int v, int d, int from, int via)
+    {
+        if (distances[v] == INF) touched.push_back(v);
+        distances[v] = d;
+        parent[v] = from;
+        middle[v] = via;
+        pq.push(v, d);
+    }
+};
+
+// Expands the two parent chains that meet at meet into original vertices.
+void unpack_ch_path(const ContractionHierarchy& ch, const CHSearch (&search)[2], int source, int destination, int meet,
+                    vector<int>& path)
+{
+    // hierarchy arcs source -> meet -> destination as (from, to, middle)
+    vector<tuple<int, int, int>> arcs;
+    for (int x = meet; x != source; x = search[0].parent[x])
+        arcs.emplace_back(search[0].parent[x], x, search[0].middle[x]);
+    reverse(arcs.begin(), arcs.end());
+    for (int x = meet; x != destination; x = search[1].parent[x])
+        arcs.emplace_back(x, search[1].parent[x], search[1].middle[x]);
+
+    // a shortcut u -> w via m stands for u -> m (a down arc of m) then m -> w (an up arc of m)
+    path.push_back(source);
+    vector<tuple<int, int, int>> stack;
+    for (const auto& arc : arcs) {
+        stack.push_back(arc);
+        while (!stack.empty()) {
+            auto [u, w, m] = stack.back();
+            stack.pop_back();
+            if (m == -1) {
+                path.push_back(w);
+                continue;
+            }
+            stack.emplace_back(m, w, find_arc(ch.upward(m), w).middle);
+            stack.emplace_back(u, m, find_arc(ch.downward(m), u).middle);
+        }
+    }
+}
+
+bool valid_offsets(const vector<int>& offsets, uint64_t numArcs)
+{
+    if (offsets.front() != 0 || static_cast<uint64_t>(offsets.back()) != numArcs) return false;
+    return is_sorted(offsets.begin(), offsets.end());
+}
+
+}
+
+void build_contraction_hierarchy(const CSRGraph& G, ContractionHierarchy& ch)
+{
+    Contractor(G).run(ch);
+}
+
+void save_contraction_hierarchy(const ContractionHierarchy& ch, const string& filename)
+{
+    ofstream out(filename, ios::binary);
+    if (!out)
+        throw runtime_error("Can't open output file");
+
+    CHFileHeader header{};
+    memcpy(header.magic, CH_FILE_MAGIC, sizeof(header.magic));
+    header.version = CH_FILE_VERSION;
+    header.arcSize = sizeof(CHArc);
+    header.numVertices = ch.numVertices;
+    header.numUp = ch.up.size();
+    header.numDown = ch.down.size();
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    write_array(out, ch.rank);
+    write_array(out, ch.up_offsets);
+    write_array(out, ch.up);
+    write_array(out, ch.down_offsets);
+    write_array(out, ch.down);
+    if (!out)
+        throw runtime_error("Can't write output file");
+}
+
+void load_contraction_hierarchy(const string& filename, ContractionHierarchy& ch)
+{
+    ifstream in(filename, ios::binary);
+    if (!in)
+        throw runtime_error("Can't open input file");
+
+    CHFileHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || memcmp(header.magic, CH_FILE_MAGIC, sizeof(header.magic)) != 0)
+        throw runtime_error("Not a contraction hierarchy file");
+    if (header.version != CH_FILE_VERSION || header.arcSize != sizeof(CHArc))
+        throw runtime_error("Unsupported contraction hierarchy version");
+    uint64_t limit = numeric_limits<int>::max();
+    if (header.numVertices >= limit || header.numUp > limit || header.numDown > limit)
+        throw runtime_error("Corrupt contraction hierarchy file");
+
+    int n = header.numVertices;
+    ch.numVertices = n;
+    read_array(in, ch.rank, n);
+    read_array(in, ch.up_offsets, n + 1);
+    read_array(in, ch.up, header.numUp);
+    read_array(in, ch.down_offsets, n + 1);
+    read_array(in, ch.down, header.numDown);
+    if (!in || in.peek() != EOF)
+        throw runtime_error("Truncated contraction hierarchy file");
+    if (!valid_offsets(ch.up_offsets, header.numUp) || !valid_offsets(ch.down_offsets, header.numDown))
+        throw runtime_error("Corrupt contraction hierarchy file");
+    for (const vector<CHArc>* arcs : {&ch.up, &ch.down})
+        for (const CHArc& a : *arcs)
+            if (a.dst < 0 || a.dst >= n || a.middle < -1 || a.middle >= n)
+                throw runtime_error("Corrupt contraction hierarchy file");
+}
+
+int ch_shortest_path(const ContractionHierarchy& ch, int source, int destination, vector<int>& path, SearchStats* stats)
+{
+    if (source < 0 || source >= ch.numVertices || destination < 0 || destination >= ch.numVertices)
+        throw runtime_error("Vertex out of range");
+
+    SearchStats local;
+    PhaseTimer timer;
+    // side 0 climbs up arcs from source, side 1 climbs down arcs backwards from destination
+    thread_local CHSearch search[2];
+    [[maybe_unused]] size_t held = search[0].bytes() + search[1].bytes();
+    for (int side : {0, 1}) {
+        search[side].prepare(ch.numVertices);
+        search[side].reach(side == 0 ? source : destination, 0, -1, -1);
+    }
+    HW9_COUNT(local.heap_pushes = 2);
+    timer.lap(local.setup_time);
+
+    int best = INF, meet = -1;
+    for (;;) {
+        // a side is finished once its closest vertex can't beat best
+        bool open[2];
+        for (int side : {0, 1})
+            open[side] = !search[side].pq.empty() && search[side].pq.top_key() < best;
+        if (!open[0] && !open[1]) break;
+        int side = !open[1] || (open[0] && search[0].pq.top_key() <= search[1].pq.top_key()) ? 0 : 1;
+
+        HW9_COUNT(local.queue_peak = max<uint64_t>(local.queue_peak, search[0].pq.size() + search[1].pq.size()));
+        CHSearch& s = search[side];
+        int x = s.pq.pop();
+        HW9_COUNT(++local.vertices_settled);
+        int other = search[1 - side].distances[x];
+        if (other != INF && s.distances[x] + other < best) {
+            best = s.distances[x] + other;
+            meet = x;
+        }
+        for (const CHArc& a : side == 0 ? ch.upward(x) : ch.downward(x)) {
+            int d = s.distances[x] + a.weight;
+            if (d < s.distances[a.dst]) {
+                s.reach(a.dst, d, x, a.middle);
+                HW9_COUNT(++local.edges_relaxed);
+                HW9_COUNT(++local.heap_pushes);
+            }
+        }
+    }
+    timer.lap(local.search_time);
+    // the scratch is reused, so only what it had to grow by counts
+    HW9_COUNT(local.bytes_allocated = search[0].bytes() + search[1].bytes() - held);
+
+    path.clear();
+    if (best != INF) unpack_ch_path(ch, search, source, destination, meet, path);
+    timer.lap(local.path_time);
+    report_search_stats(SearchEngine::Dijkstra, local, stats);
+    return best;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "dijkstra_heaps.h"
+#include <cstdint>
+
+// Arc of a contraction hierarchy. middle is -1 for an original edge; for a
+// shortcut it is the vertex the shortcut skips over.
+struct CHArc {
+    int dst=0;
+    int weight=0;
+    int middle=-1;
+};
+
+// A graph augmented with shortcuts so that every shortest path can be found
+// by searching only towards more important (higher-ranked) vertices.
+struct ContractionHierarchy {
+    int numVertices=0;
+    vector<int> rank;         // position of each vertex in the contraction order
+    vector<int> up_offsets;   // up[up_offsets[u], up_offsets[u+1]): arcs u -> dst, rank[dst] > rank[u]
+    vector<CHArc> up;
+    vector<int> down_offsets; // down[down_offsets[v], down_offsets[v+1]): arcs dst -> v, rank[dst] > rank[v]
+    vector<CHArc> down;
+
+    span<const CHArc> upward(int u) const
+    {
+        return span<const CHArc>(up).subspan(up_offsets[u], up_offsets[u + 1] - up_offsets[u]);
+    }
+    span<const CHArc> downward(int v) const
+    {
+        return span<const CHArc>(down).subspan(down_offsets[v], down_offsets[v + 1] - down_offsets[v]);
+    }
+};
+
+// Contracts vertices in edge-difference order, adding a shortcut u -> w
+// whenever removing v would lose the only shortest u -> v -> w path.
+void build_contraction_hierarchy(const CSRGraph& G, ContractionHierarchy& ch);
+
+// Binary hierarchy file, native byte order:
+//   CHFileHeader
+//   int32 rank[numVertices]
+//   int32 up_offsets[numVertices + 1],   CHArc up[numUp]
+//   int32 down_offsets[numVertices + 1], CHArc down[numDown]
+constexpr char CH_FILE_MAGIC[8] = {'H', 'W', '9', 'C', 'H', 0, 0, 0};
+constexpr uint32_t CH_FILE_VERSION = 1;
+
+struct CHFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t arcSize; // sizeof(CHArc) of the writer
+    uint64_t numVertices;
+    uint64_t numUp;
+    uint64_t numDown;
+};
+
+void save_contraction_hierarchy(const ContractionHierarchy& ch, const string& filename);
+void load_contraction_hierarchy(const string& filename, ContractionHierarchy& ch);
+
+// Upward-only search from both ends. Returns the distance (INF if
+// unreachable) and fills path with original vertices in extract_shortest_path order.
+// Reports to SearchEngine::Dijkstra; path_time covers unpacking shortcuts.
+int ch_shortest_path(const ContractionHierarchy& ch, int source, int destination, vector<int>& path,
+                     SearchStats* stats = nullptr);
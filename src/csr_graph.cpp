@@ -0,0 +1,59 @@
+#include "csr_graph.h"
+#include "dijkstra_heaps.h"
+
+void build_csr_graph(int numVertices, const vector<Edge>& edges, CSRGraph& G)
+{
+    if (edges.size() > static_cast<size_t>(numeric_limits<int>::max()))
+        throw runtime_error("Too many edges for CSRGraph");
+
+    G.numVertices = numVertices;
+    G.offsets.assign(numVertices + 1, 0);
+    for (const Edge& e : edges) {
+        if (e.src < 0 || e.src >= numVertices || e.dst < 0 || e.dst >= numVertices)
+            throw runtime_error("Edge endpoint out of range");
+        ++G.offsets[e.src + 1];
+    }
+    for (int u = 0; u < numVertices; ++u)
+        G.offsets[u + 1] += G.offsets[u];
+
+    // stable counting sort: each row keeps input order
+    G.arcs.resize(edges.size());
+    vector<int> cursor(G.offsets.begin(), G.offsets.end() - 1);
+    for (const Edge& e : edges)
+        G.arcs[cursor[e.src]++] = Arc{e.dst, e.weight};
+}
+
+void graph_to_csr(const Graph& G, CSRGraph& csr)
+{
+    vector<Edge> edges;
+    for (const vector<Edge>& row : G)
+        edges.insert(edges.end(), row.begin(), row.end());
+    build_csr_graph(G.size(), edges, csr);
+}
+
+istream& operator>>(istream& in, CSRGraph& G)
+{
+    int numVertices;
+    if (!(in >> numVertices))
+        throw runtime_error("Unable to find input file");
+    vector<Edge> edges;
+    for (Edge e; in >> e;)
+        edges.push_back(e);
+    build_csr_graph(numVertices, edges, G);
+    return in;
+}
+
+void file_to_graph(const string& filename, CSRGraph& G)
+{
+    ifstream in(filename);
+    if (!in) {
+        throw runtime_error("Can't open input file");
+    }
+    in >> G;
+    in.close();
+}
+
+vector<int> dijkstra_shortest_path(const CSRGraph& G, int source, vector<int>& previous, SearchStats* stats)
+{
+    return dijkstra_shortest_path<FourAryHeap>(G, source, previous, stats);
+}
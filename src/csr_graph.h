@@ -0,0 +1,30 @@
+#pragma once
+
+#include "dijkstras.h"
+#include <span>
+
+// Out-edge of a CSRGraph; the source is the row it is stored in.
+struct Arc {
+    int dst=0;
+    int weight=0;
+};
+
+// Compressed sparse row graph: the out-edges of u are arcs[offsets[u], offsets[u+1]),
+// in the order they appear in the input.
+struct CSRGraph {
+    int numVertices=0;
+    vector<int> offsets;
+    vector<Arc> arcs;
+
+    span<const Arc> neighbors(int u) const
+    {
+        return span<const Arc>(arcs).subspan(offsets[u], offsets[u + 1] - offsets[u]);
+    }
+};
+
+void build_csr_graph(int numVertices, const vector<Edge>& edges, CSRGraph& G);
+void graph_to_csr(const Graph& G, CSRGraph& csr);
+istream& operator>>(istream& in, CSRGraph& G);
+void file_to_graph(const string& filename, CSRGraph& G);
+
+vector<int> dijkstra_shortest_path(const CSRGraph& G, int source, vector<int>& previous, SearchStats* stats = nullptr);
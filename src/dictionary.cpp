@@ -0,0 +1,91 @@
+#include "dictionary.h"
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <iterator>
+#include <limits>
+
+uint64_t hash_word(string_view word)
+{
+    uint64_t h = FNV_OFFSET_BASIS;
+    for (char c : word) {
+        h ^= static_cast<unsigned char>(c);
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+
+int Dictionary::find(string_view word) const
+{
+    if (slots.empty()) return -1;
+    size_t mask = slots.size() - 1;
+    for (size_t i = hash_word(word) & mask;; i = (i + 1) & mask) {
+        int id = slots[i];
+        if (id < 0) return -1;
+        if (this->word(id) == word) return id;
+    }
+}
+
+
+void build_dictionary(vector<string_view> words, Dictionary& dict)
+{
+    sort(words.begin(), words.end());
+    words.erase(unique(words.begin(), words.end()), words.end());
+
+    size_t total = 0;
+    for (string_view w : words) total += w.size();
+    if (total > numeric_limits<uint32_t>::max())
+        throw runtime_error("Dictionary too large");
+
+    dict.chars.clear();
+    dict.chars.reserve(total);
+    dict.records.clear();
+    dict.records.reserve(words.size());
+    for (string_view w : words) {
+        dict.records.push_back({static_cast<uint32_t>(dict.chars.size()), static_cast<uint32_t>(w.size())});
+        dict.chars.append(w);
+    }
+
+    // counting sort by length: same-length runs for batched screening
+    size_t max_length = 0;
+    for (const WordRecord& r : dict.records) max_length = max<size_t>(max_length, r.length);
+    dict.length_start.assign(max_length + 2, 0);
+    for (const WordRecord& r : dict.records) ++dict.length_start[r.length + 1];
+    for (size_t len = 0; len <= max_length; ++len) dict.length_start[len + 1] += dict.length_start[len];
+    dict.by_length.resize(dict.size());
+    vector<int> cursor(dict.length_start.begin(), dict.length_start.end() - 1);
+    for (int id = 0; id < dict.size(); ++id) dict.by_length[cursor[dict.records[id].length]++] = id;
+
+    // at most half full keeps probe sequences short
+    dict.slots.assign(bit_ceil(2 * words.size() + 1), -1);
+    size_t mask = dict.slots.size() - 1;
+    for (int id = 0; id < dict.size(); ++id) {
+        size_t i = hash_word(dict.word(id)) & mask;
+        while (dict.slots[i] >= 0) i = (i + 1) & mask;
+        dict.slots[i] = id;
+    }
+}
+
+
+void build_dictionary(const set<string>& word_list, Dictionary& dict)
+{
+    build_dictionary(vector<string_view>(word_list.begin(), word_list.end()), dict);
+}
+
+
+void load_words(Dictionary& dict, const string& file_name)
+{
+    ifstream file(file_name);
+    string text(istreambuf_iterator<char>(file), {});
+    file.close();
+
+    vector<string_view> words;
+    for (size_t i = 0; i < text.size();) {
+        while (i < text.size() && isspace(static_cast<unsigned char>(text[i]))) ++i;
+        size_t start = i;
+        while (i < text.size() && !isspace(static_cast<unsigned char>(text[i]))) ++i;
+        if (i > start) words.emplace_back(text.data() + start, i - start);
+    }
+    build_dictionary(move(words), dict);
+}
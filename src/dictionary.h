@@ -0,0 +1,42 @@
+#pragma once
+
+#include "ladder.h"
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// 64-bit FNV-1a, used for every word hash.
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t hash_word(string_view word);
+
+// Fixed-size slice of Dictionary::chars.
+struct WordRecord {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+};
+
+// Read-only word list kept in one contiguous character arena. Words are
+// deduplicated and get integer ids in sorted order (the order set<string>
+// iterates in); lookups go through an open-addressing table of ids.
+struct Dictionary {
+    string chars;               // every word back to back
+    vector<WordRecord> records; // id -> slice of chars
+    vector<int32_t> slots;      // linear-probing hash table of ids, -1 = empty
+    vector<int> by_length;      // ids ordered by (length, id)
+    vector<int> length_start;   // words of length L are by_length[length_start[L], length_start[L+1])
+
+    int size() const { return records.size(); }
+    string_view word(int id) const { return string_view(chars).substr(records[id].offset, records[id].length); }
+    span<const int> words_of_length(size_t length) const
+    {
+        if (length + 1 >= length_start.size()) return {};
+        return span<const int>(by_length).subspan(length_start[length], length_start[length + 1] - length_start[length]);
+    }
+    int find(string_view word) const;
+};
+
+void build_dictionary(vector<string_view> words, Dictionary& dict);
+void build_dictionary(const set<string>& word_list, Dictionary& dict);
+void load_words(Dictionary& dict, const string& file_name);
@@ -0,0 +1,163 @@
+#include "dijkstra_engine.h"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+void DijkstraScratch::prepare(int numVertices)
+{
+    if (static_cast<int>(stamp.size()) != numVertices) {
+        distances.assign(numVertices, INF);
+        previous.assign(numVertices, -1);
+        stamp.assign(numVertices, 0);
+        wanted.assign(numVertices, 0);
+        pq.reset(numVertices);
+        epoch = 0;
+    }
+    if (++epoch == 0) { // wrapped: old stamps could look current again
+        fill(stamp.begin(), stamp.end(), 0);
+        fill(wanted.begin(), wanted.end(), 0);
+        epoch = 1;
+    }
+}
+
+size_t DijkstraScratch::bytes() const
+{
+    return (distances.capacity() + previous.capacity()) * sizeof(int)
+           + (stamp.capacity() + wanted.capacity()) * sizeof(uint32_t) + pq.bytes();
+}
+
+void dijkstra_with_scratch(const CSRGraph& G, int source, span<const int> targets, DijkstraScratch& s, SearchStats* stats)
+{
+    SearchStats local;
+    PhaseTimer timer;
+    [[maybe_unused]] size_t held = s.bytes();
+    s.prepare(G.numVertices);
+    int remaining = 0;
+    for (int t : targets) {
+        if (s.wanted[t] != s.epoch) {
+            s.wanted[t] = s.epoch;
+            ++remaining;
+        }
+    }
+
+    s.stamp[source] = s.epoch;
+    s.distances[source] = 0;
+    s.previous[source] = -1;
+    s.pq.push(source, 0);
+    HW9_COUNT(local.heap_pushes = 1);
+    timer.lap(local.setup_time);
+
+    while (!s.pq.empty()) {
+        HW9_COUNT(local.queue_peak = max<uint64_t>(local.queue_peak, s.pq.size()));
+        int u = s.pq.pop();
+        if (s.wanted[u] == s.epoch && --remaining == 0) break;
+        HW9_COUNT(++local.vertices_settled);
+
+        // the indexed heap never returns stale entries, and with non-negative
+        // weights a settled vertex can't be improved, so no visited array
+        int du = s.distances[u];
+        for (const Arc& a : G.neighbors(u)) {
+            int v = a.dst, d = du + a.weight;
+            if (s.stamp[v] != s.epoch || d < s.distances[v]) {
+                s.stamp[v] = s.epoch;
+                s.distances[v] = d;
+                s.previous[v] = u;
+                s.pq.push(v, d);
+                HW9_COUNT(++local.edges_relaxed);
+                HW9_COUNT(++local.heap_pushes);
+            }
+        }
+    }
+    HW9_COUNT(local.bytes_allocated = s.bytes() - held);
+    s.pq.clear();
+    timer.lap(local.search_time);
+    report_search_stats(SearchEngine::Dijkstra, local, stats);
+}
+
+namespace {
+
+// Query indices owned by one worker: the owner pops from the back, idle
+// workers steal from the front.
+struct WorkQueue {
+    mutex m;
+    deque<size_t> items;
+
+    bool pop_back(size_t& i)
+    {
+        lock_guard<mutex> lock(m);
+        if (items.empty()) return false;
+        i = items.back();
+        items.pop_back();
+        return true;
+    }
+
+    bool steal_front(size_t& i)
+    {
+        lock_guard<mutex> lock(m);
+        if (items.empty()) return false;
+        i = items.front();
+        items.pop_front();
+        return true;
+    }
+};
+
+DijkstraResult answer(const CSRGraph& G, const DijkstraQuery& q, DijkstraScratch& s)
+{
+    dijkstra_with_scratch(G, q.source, q.targets, s);
+    DijkstraResult r;
+    if (q.targets.empty()) {
+        r.distances.resize(G.numVertices);
+        for (int v = 0; v < G.numVertices; ++v) r.distances[v] = s.distance(v);
+    } else {
+        r.distances.reserve(q.targets.size());
+        for (int t : q.targets) r.distances.push_back(s.distance(t));
+    }
+    return r;
+}
+
+}
+
+vector<DijkstraResult> run_dijkstra_queries(const CSRGraph& G, const vector<DijkstraQuery>& queries, int threads)
+{
+    // validate up front: an exception inside a worker would terminate the process
+    auto in_range = [&](int v) { return v >= 0 && v < G.numVertices; };
+    for (const DijkstraQuery& q : queries) {
+        if (!in_range(q.source) || !all_of(q.targets.begin(), q.targets.end(), in_range))
+            throw runtime_error("Query vertex out of range");
+    }
+    // with a negative cycle the search below would never run out of improvements
+    if (any_of(G.arcs.begin(), G.arcs.end(), [](const Arc& a) { return a.weight < 0; }))
+        throw runtime_error("Negative edge weight");
+
+    vector<DijkstraResult> results(queries.size());
+    if (queries.empty()) return results;
+
+    int numWorkers = threads > 0 ? threads : max(1u, thread::hardware_concurrency());
+    numWorkers = min<size_t>(numWorkers, queries.size());
+
+    // a contiguous block per worker; stealing evens out uneven query costs
+    vector<WorkQueue> queues(numWorkers);
+    for (size_t i = 0; i < queries.size(); ++i)
+        queues[i * numWorkers / queries.size()].items.push_back(i);
+
+    auto worker = [&](int w) {
+        DijkstraScratch scratch;
+        size_t i;
+        for (;;) {
+            bool found = queues[w].pop_back(i);
+            for (int k = 1; !found && k < numWorkers; ++k)
+                found = queues[(w + k) % numWorkers].steal_front(i);
+            if (!found) return; // nothing is ever re-queued, so empty means done
+            results[i] = answer(G, queries[i], scratch);
+        }
+    };
+
+    vector<thread> pool;
+    for (int w = 1; w < numWorkers; ++w)
+        pool.emplace_back(worker, w);
+    worker(0);
+    for (thread& t : pool)
+        t.join();
+    return results;
+}
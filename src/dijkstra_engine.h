@@ -0,0 +1,44 @@
+#pragma once
+
+#include "dijkstra_heaps.h"
+#include <cstdint>
+
+// Distances from source to each of targets, or to every vertex when targets is empty.
+struct DijkstraQuery {
+    int source=0;
+    vector<int> targets;
+};
+
+struct DijkstraResult {
+    vector<int> distances; // one per target (or per vertex), INF if unreachable
+};
+
+// Buffers one thread reuses across queries. A vertex's entries are valid only
+// while its stamp equals the current epoch, so starting a query bumps the
+// epoch instead of refilling O(V) arrays.
+struct DijkstraScratch {
+    vector<int> distances;
+    vector<int> previous;
+    vector<uint32_t> stamp;  // distances/previous valid iff stamp == epoch
+    vector<uint32_t> wanted; // unsettled target iff wanted == epoch
+    uint32_t epoch=0;
+    FourAryHeap pq;
+
+    void prepare(int numVertices);
+    size_t bytes() const;
+    int distance(int v) const { return stamp[v] == epoch ? distances[v] : INF; }
+    int parent(int v) const { return stamp[v] == epoch ? previous[v] : -1; }
+};
+
+// Single-source run on reused buffers. Stops as soon as every target is
+// settled; with no targets every reachable vertex is settled. Reports to
+// SearchEngine::Dijkstra; bytes_allocated is what the scratch had to grow by.
+// Weights must be non-negative: settled vertices are not marked, so a
+// negative cycle keeps improving forever.
+void dijkstra_with_scratch(const CSRGraph& G, int source, span<const int> targets, DijkstraScratch& scratch,
+                           SearchStats* stats = nullptr);
+
+// Answers a batch on `threads` workers (0 = one per hardware thread) that
+// steal from each other's queues; results come back in request order.
+// Throws runtime_error for an out-of-range vertex or a negative weight.
+vector<DijkstraResult> run_dijkstra_queries(const CSRGraph& G, const vector<DijkstraQuery>& queries, int threads = 0);
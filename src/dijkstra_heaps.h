@@ -0,0 +1,288 @@
+#pragma once
+
+#include "csr_graph.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <functional>
+
+// Priority queues over vertex ids for dijkstra_shortest_path<Heap>. Each one
+// offers reset(numVertices), empty(), size(), push(v, key), which inserts v
+// or lowers its key, pop(), which removes and returns a vertex with the
+// smallest key, clear(), which only touches live entries, and bytes(), the
+// memory its arrays currently hold.
+
+// Binary heap with lazy deletion: push adds a new entry every time and pop may
+// return a vertex that was already popped. This is the original queue.
+class LazyBinaryHeap {
+public:
+    void reset(int /*numVertices*/) { clear(); }
+    bool empty() const { return heap.empty(); }
+    int size() const { return heap.size(); }
+    void push(int v, int key)
+    {
+        heap.push_back({key, v});
+        push_heap(heap.begin(), heap.end(), greater<Entry>());
+    }
+    int pop()
+    {
+        pop_heap(heap.begin(), heap.end(), greater<Entry>());
+        int v = heap.back().second;
+        heap.pop_back();
+        return v;
+    }
+    void clear() { heap.clear(); }
+    size_t bytes() const { return heap.capacity() * sizeof(Entry); }
+
+private:
+    using Entry = pair<int, int>; // (key, vertex)
+    vector<Entry> heap;           // what priority_queue keeps, but its capacity is visible
+};
+
+
+// D-ary heap that knows where every vertex sits, so push on a queued vertex
+// is a real decrease-key and the heap never holds more than V entries.
+template <int D>
+class IndexedDaryHeap {
+public:
+    void reset(int numVertices)
+    {
+        heap.clear();
+        pos.assign(numVertices, -1);
+    }
+    bool empty() const { return heap.empty(); }
+    int size() const { return heap.size(); }
+    int top_key() const { return heap.front().key; }
+
+    void push(int v, int key)
+    {
+        int i = pos[v];
+        if (i < 0) {
+            i = heap.size();
+            heap.push_back({key, v});
+        } else if (key < heap[i].key) {
+            heap[i].key = key;
+        } else {
+            return;
+        }
+        sift_up(i);
+    }
+
+    int pop()
+    {
+        int v = heap.front().vertex;
+        pos[v] = -1;
+        Node last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap.front() = last;
+            pos[last.vertex] = 0;
+            sift_down(0);
+        }
+        return v;
+    }
+
+    void clear()
+    {
+        for (const Node& n : heap) pos[n.vertex] = -1;
+        heap.clear();
+    }
+    size_t bytes() const { return heap.capacity() * sizeof(Node) + pos.capacity() * sizeof(int); }
+
+private:
+    struct Node {
+        int key;
+        int vertex;
+    };
+
+    void sift_up(int i)
+    {
+        Node n = heap[i];
+        while (i > 0) {
+            int parent = (i - 1) / D;
+            if (heap[parent].key <= n.key) break;
+            heap[i] = heap[parent];
+            pos[heap[i].vertex] = i;
+            i = parent;
+        }
+        heap[i] = n;
+        pos[n.vertex] = i;
+    }
+
+    void sift_down(int i)
+    {
+        Node n = heap[i];
+        int count = heap.size();
+        for (;;) {
+            int first = D * i + 1;
+            if (first >= count) break;
+            int best = first;
+            for (int c = first + 1; c < min(first + D, count); ++c)
+                if (heap[c].key < heap[best].key) best = c;
+            if (n.key <= heap[best].key) break;
+            heap[i] = heap[best];
+            pos[heap[i].vertex] = i;
+            i = best;
+        }
+        heap[i] = n;
+        pos[n.vertex] = i;
+    }
+
+    vector<Node> heap;
+    vector<int> pos; // vertex -> index in heap, -1 if absent
+};
+
+using FourAryHeap = IndexedDaryHeap<4>;
+
+
+// Monotone radix heap for non-negative integer keys: a key may never be
+// smaller than the last key popped, which Dijkstra guarantees for
+// non-negative weights. Bucket b holds keys whose highest bit differing from
+// the last popped key is bit b - 1, so each vertex moves down at most 32 times.
+class RadixHeap {
+public:
+    void reset(int numVertices)
+    {
+        clear();
+        key.assign(numVertices, 0);
+        bucket_of.assign(numVertices, -1);
+        pos.assign(numVertices, 0);
+    }
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+
+    void push(int v, int k)
+    {
+        if (k < 0 || static_cast<unsigned>(k) < last)
+            throw runtime_error("RadixHeap keys must be non-negative and monotone");
+        if (bucket_of[v] >= 0) {
+            if (static_cast<unsigned>(k) >= key[v]) return;
+            remove(v);
+        } else {
+            ++count;
+        }
+        key[v] = k;
+        insert(v);
+    }
+
+    int pop()
+    {
+        if (buckets[0].empty()) {
+            int b = 1;
+            while (buckets[b].empty()) ++b;
+            last = numeric_limits<unsigned>::max();
+            for (int v : buckets[b]) last = min(last, key[v]);
+            // every key in bucket b now differs from last in a lower bit
+            moving.swap(buckets[b]);
+            for (int v : moving) insert(v);
+            moving.clear();
+        }
+        int v = buckets[0].back();
+        buckets[0].pop_back();
+        bucket_of[v] = -1;
+        --count;
+        return v;
+    }
+
+    void clear()
+    {
+        for (vector<int>& bucket : buckets) {
+            for (int v : bucket) bucket_of[v] = -1;
+            bucket.clear();
+        }
+        last = 0;
+        count = 0;
+    }
+    size_t bytes() const
+    {
+        size_t total = (moving.capacity() + pos.capacity()) * sizeof(int) + key.capacity() * sizeof(unsigned)
+                       + bucket_of.capacity() * sizeof(int8_t);
+        for (const vector<int>& bucket : buckets) total += bucket.capacity() * sizeof(int);
+        return total;
+    }
+
+private:
+    static constexpr int NUM_BUCKETS = 33;
+
+    int bucket_index(unsigned k) const { return k == last ? 0 : 32 - countl_zero(k ^ last); }
+
+    void insert(int v)
+    {
+        int b = bucket_index(key[v]);
+        bucket_of[v] = b;
+        pos[v] = buckets[b].size();
+        buckets[b].push_back(v);
+    }
+
+    void remove(int v)
+    {
+        vector<int>& bucket = buckets[bucket_of[v]];
+        int moved = bucket.back();
+        bucket[pos[v]] = moved;
+        pos[moved] = pos[v];
+        bucket.pop_back();
+        bucket_of[v] = -1;
+    }
+
+    array<vector<int>, NUM_BUCKETS> buckets;
+    vector<int> moving;
+    vector<unsigned> key;
+    vector<int8_t> bucket_of; // -1 if absent
+    vector<int> pos;          // index inside its bucket
+    unsigned last = 0;
+    int count = 0;
+};
+
+
+inline int num_vertices(const Graph& G) { return G.size(); }
+inline int num_vertices(const CSRGraph& G) { return G.numVertices; }
+inline const vector<Edge>& out_edges(const Graph& G, int u) { return G[u]; }
+inline span<const Arc> out_edges(const CSRGraph& G, int u) { return G.neighbors(u); }
+
+// Dijkstra over any graph with num_vertices/out_edges, using the queue chosen
+// at the call site, e.g. dijkstra_shortest_path<RadixHeap>(G, 0, previous).
+template <class Heap, class G>
+vector<int> dijkstra_shortest_path(const G& graph, int source, vector<int>& previous, SearchStats* stats = nullptr)
+{
+    SearchStats local;
+    PhaseTimer timer;
+    int numVert = num_vertices(graph);
+    vector<int> distances(numVert, INF);
+    distances[source] = 0;
+    previous.assign(numVert, -1);
+    vector<bool> visited(numVert, false);
+
+    Heap pq;
+    pq.reset(numVert);
+    pq.push(source, 0);
+    HW9_COUNT(local.heap_pushes = 1);
+    timer.lap(local.setup_time);
+
+    while (!pq.empty()) {
+        HW9_COUNT(local.queue_peak = max<uint64_t>(local.queue_peak, pq.size()));
+        int u = pq.pop();
+
+        if (visited[u]) { // only lazy heaps hand out stale entries
+            HW9_COUNT(++local.stale_pops);
+            continue;
+        }
+        visited[u] = true;
+        HW9_COUNT(++local.vertices_settled);
+
+        for (const auto& e : out_edges(graph, u)) {
+            int v = e.dst, weight = e.weight;
+
+            if (!visited[v] && distances[u] + weight < distances[v]) {
+                distances[v] = distances[u] + weight;
+                previous[v] = u;
+                pq.push(v, distances[v]);
+                HW9_COUNT(++local.edges_relaxed);
+                HW9_COUNT(++local.heap_pushes);
+            }
+        }
+    }
+    timer.lap(local.search_time);
+    HW9_COUNT(local.bytes_allocated = numVert * 2 * sizeof(int) + visited.capacity() / 8 + pq.bytes());
+    report_search_stats(SearchEngine::Dijkstra, local, stats);
+    return distances;
+}
@@ -4,10 +4,14 @@ struct EdgeComparison {
     bool operator()(const Edge& u, const Edge& v) { return u.weight > v.weight; }
 };
 
-using EdgeMinHeap = priority_queue<Edge, vector<Edge>, EdgeComparison>;
+struct EdgeMinHeap : priority_queue<Edge, vector<Edge>, EdgeComparison> {
+    size_t bytes() const { return c.capacity() * sizeof(Edge); }
+};
 
-vector<int> dijkstra_shortest_path(const Graph& G, int source, vector<int>& previous)
+vector<int> dijkstra_shortest_path(const Graph& G, int source, vector<int>& previous, SearchStats* stats)
 {
+    SearchStats local;
+    PhaseTimer timer;
     int numVert = G.size();
     vector<int> distances(numVert, numeric_limits<int>::max()); // distances
     distances[source] = 0;
@@ -16,14 +20,21 @@ vector<int> dijkstra_shortest_path(const Graph& G, int source, vector<int>& prev
 
     EdgeMinHeap pq;
     pq.push(Edge(source, source, 0));
+    HW9_COUNT(local.heap_pushes = 1);
+    timer.lap(local.setup_time);
 
     while (!pq.empty()) {
+        HW9_COUNT(local.queue_peak = max<uint64_t>(local.queue_peak, pq.size()));
         Edge e = pq.top();
         pq.pop();
         int u = e.dst;
 
-        if (visited[u]) continue; // mark visited if visited
+        if (visited[u]) { // mark visited if visited
+            HW9_COUNT(++local.stale_pops);
+            continue;
+        }
         visited[u] = true;
+        HW9_COUNT(++local.vertices_settled);
 
         for (const Edge& neighbor : G[u]) { // iterate through all neighbors and update distances
             int v = neighbor.dst, weight = neighbor.weight;
@@ -32,10 +43,15 @@ vector<int> dijkstra_shortest_path(const Graph& G, int source, vector<int>& prev
                 distances[v] = distances[u] + weight;
                 previous[v] = u;
                 pq.push(Edge(u, v, distances[v]));
+                HW9_COUNT(++local.edges_relaxed);
+                HW9_COUNT(++local.heap_pushes);
             }
         }
 
     }
+    timer.lap(local.search_time);
+    HW9_COUNT(local.bytes_allocated = numVert * 2 * sizeof(int) + visited.capacity() / 8 + pq.bytes());
+    report_search_stats(SearchEngine::Dijkstra, local, stats);
     return distances;
 }
 
@@ -1,9 +1,12 @@
+#pragma once
+
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <queue>
 #include <limits>
 #include <stack>
+#include "search_stats.h"
 
 using namespace std;
 
@@ -47,6 +50,6 @@ inline void file_to_graph(const string& filename, Graph& G) {
     in.close();
 }
 
-vector<int> dijkstra_shortest_path(const Graph& G, int source, vector<int>& previous);
+vector<int> dijkstra_shortest_path(const Graph& G, int source, vector<int>& previous, SearchStats* stats = nullptr);
 vector<int> extract_shortest_path(const vector<int>& /*distances*/, const vector<int>& previous, int destination);
 void print_path(const vector<int>& v, int total);
@@ -0,0 +1,367 @@
+#include "edit_distance_batch.h"
+#include <algorithm>
+#include <bit>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define HW9_X86 1
+#include <immintrin.h>
+// vector types only cross screen_columns, which is always inlined into a
+// function compiled for the matching instruction set
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+namespace {
+
+// The query, and when it fits in a machine word also its per-character
+// bitmasks for Myers' bit-parallel edit distance.
+struct Query {
+    string_view chars;
+    bool bit_parallel = false;
+    uint64_t peq[256] = {};   // bit i of peq[c] is set iff chars[i] == c
+
+    explicit Query(string_view query) : chars(query), bit_parallel(query.size() <= 64)
+    {
+        if (bit_parallel)
+            for (size_t i = 0; i < query.size(); ++i)
+                peq[static_cast<unsigned char>(query[i])] |= uint64_t{1} << i;
+    }
+};
+
+// Myers' algorithm in Hyyrö's formulation for global distance: one column of
+// the DP matrix per candidate character, packed as vertical +1/-1 deltas.
+// Stops once the bottom cell can no longer come back down to d.
+bool myers_within(const Query& q, string_view c, int d)
+{
+    const uint64_t high = uint64_t{1} << (q.chars.size() - 1);
+    uint64_t vp = ~uint64_t{0}, vn = 0;
+    int score = q.chars.size();
+    for (size_t j = 0; j < c.size(); ++j) {
+        uint64_t eq = q.peq[static_cast<unsigned char>(c[j])];
+        uint64_t xv = eq | vn;
+        uint64_t xh = (((eq & vp) + vp) ^ vp) | eq;
+        uint64_t ph = vn | ~(xh | vp);
+        uint64_t mh = vp & xh;
+        score += (ph & high) != 0;
+        score -= (mh & high) != 0;
+        if (score - static_cast<int>(c.size() - j - 1) > d) return false;
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        vp = mh | ~(xv | ph);
+        vn = ph & xv;
+    }
+    return score <= d;
+}
+
+// stops once > limit
+int mismatches(const char* a, const char* b, size_t n, int limit)
+{
+    int diff = 0;
+    for (size_t i = 0; i < n && diff <= limit; ++i)
+        diff += a[i] != b[i];
+    return diff;
+}
+
+size_t common_prefix(const char* a, const char* b, size_t n)
+{
+    size_t i = 0;
+    while (i < n && a[i] == b[i]) ++i;
+    return i;
+}
+
+// One candidate at a time. Random words differ within a character or two,
+// so the early exits here beat vector compares of the whole word.
+inline bool within(const Query& q, string_view c, int d)
+{
+    string_view s = q.chars;
+    size_t gap = s.size() > c.size() ? s.size() - c.size() : c.size() - s.size();
+    if (gap > static_cast<size_t>(d)) return false;
+
+    if (gap == 0) {
+        // within d substitutions is enough, and for d <= 1 also necessary
+        if (mismatches(s.data(), c.data(), s.size(), d) <= d) return true;
+        if (d <= 1) return false;
+    } else if (gap == 1) {
+        // one insertion: after the common prefix the rest must line up shifted by one
+        string_view shorter = s.size() < c.size() ? s : c;
+        string_view longer = s.size() < c.size() ? c : s;
+        size_t n = shorter.size();
+        size_t p = common_prefix(shorter.data(), longer.data(), n);
+        if (common_prefix(shorter.data() + p, longer.data() + p + 1, n - p) == n - p) return true;
+        if (d <= 1) return false;
+    }
+    if (s.empty()) return c.size() <= static_cast<size_t>(d);
+    if (q.bit_parallel) return myers_within(q, c, d);
+    return levenshtein_within(s, c, d);
+}
+
+// Sets bit i of mask iff candidates[i] is within d; the mask starts zeroed.
+void screen_words(const Dictionary& dict, const Query& q, span<const int> candidates, int d, uint64_t* mask)
+{
+    for (size_t i = 0; i < candidates.size(); ++i)
+        if (within(q, dict.word(candidates[i]), d))
+            mask[i / 64] |= uint64_t{1} << (i % 64);
+}
+
+// Lane-parallel screening keeps one byte per DP cell, capped at d + 1.
+constexpr int LANE_MAX_DISTANCE = 15;
+
+#ifdef HW9_X86
+struct Sse2Lanes {
+    using type = __m128i;
+    static constexpr size_t width = 16;
+    __attribute__((target("sse2"))) static type load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    __attribute__((target("sse2"))) static type splat(char c) { return _mm_set1_epi8(c); }
+    __attribute__((target("sse2"))) static type eq(type a, type b) { return _mm_cmpeq_epi8(a, b); }
+    __attribute__((target("sse2"))) static type add(type a, type b) { return _mm_add_epi8(a, b); }
+    __attribute__((target("sse2"))) static type min(type a, type b) { return _mm_min_epu8(a, b); }
+    __attribute__((target("sse2"))) static uint32_t bits(type a) { return _mm_movemask_epi8(a); }
+};
+
+struct Avx2Lanes {
+    using type = __m256i;
+    static constexpr size_t width = 32;
+    __attribute__((target("avx2"))) static type load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    __attribute__((target("avx2"))) static type splat(char c) { return _mm256_set1_epi8(c); }
+    __attribute__((target("avx2"))) static type eq(type a, type b) { return _mm256_cmpeq_epi8(a, b); }
+    __attribute__((target("avx2"))) static type add(type a, type b) { return _mm256_add_epi8(a, b); }
+    __attribute__((target("avx2"))) static type min(type a, type b) { return _mm256_min_epu8(a, b); }
+    __attribute__((target("avx2"))) static uint32_t bits(type a) { return _mm256_movemask_epi8(a); }
+};
+
+// Banded Levenshtein for V::width words of length len at once, one word per
+// byte lane, reading the transposed blocks of columns. Row i is the
+// i-th character of every word; band[k] holds column j = i + k - d.
+// Sets bit i of mask iff the i-th word of the run is within d.
+template <class V>
+[[gnu::always_inline]] inline void screen_columns(const Dictionary& dict, const WordColumns& columns, string_view q, size_t len, int d, uint64_t* mask)
+{
+    using T = typename V::type;
+    const int m = q.size(), n = len, width = 2 * d + 1;
+    const T one = V::splat(1), limit = V::splat(d), cap = V::splat(d + 1);
+    const size_t count = dict.words_of_length(len).size();
+    if (count == 0) return;
+    const char* blocks = columns.chars.data() + columns.start[len];
+
+    for (size_t base = 0; base < count; base += V::width) {
+        const char* block = blocks + base / WORD_COLUMN_LANES * WORD_COLUMN_LANES * len + base % WORD_COLUMN_LANES;
+        T prev[2 * LANE_MAX_DISTANCE + 1], curr[2 * LANE_MAX_DISTANCE + 1];
+        for (int k = 0; k < width; ++k)
+            prev[k] = (k >= d && k - d <= m) ? V::splat(k - d) : cap;
+
+        bool alive = true;
+        for (int i = 1; i <= n && alive; ++i) {
+            T c = V::load(block + (i - 1) * WORD_COLUMN_LANES);
+            T row_min = cap;
+            for (int k = 0; k < width; ++k) {
+                int j = i + k - d;
+                if (j < 0 || j > m) {
+                    curr[k] = cap;
+                    continue;
+                }
+                if (j == 0) {
+                    curr[k] = V::splat(min(i, d + 1));
+                } else {
+                    // substitution costs 1 unless the characters match
+                    T best = V::add(V::add(prev[k], one), V::eq(c, V::splat(q[j - 1]))); // eq is -1 per lane
+                    if (k + 1 < width) best = V::min(best, V::add(prev[k + 1], one));
+                    if (k > 0) best = V::min(best, V::add(curr[k - 1], one));
+                    curr[k] = V::min(best, cap);
+                }
+                row_min = V::min(row_min, curr[k]);
+            }
+            alive = V::bits(V::eq(V::min(row_min, limit), row_min)) != 0;
+            copy(curr, curr + width, prev);
+        }
+        if (!alive) continue;
+
+        size_t lanes = min(count - base, V::width);
+        T last = prev[m - n + d];
+        uint64_t hit = V::bits(V::eq(V::min(last, limit), last)) & ((uint64_t{1} << lanes) - 1);
+        mask[base / 64] |= hit << (base % 64);
+    }
+}
+#endif
+
+// Screens every word of length len, setting bit i of mask for the i-th word
+// of dict.words_of_length(len); the mask starts zeroed. The vector kernels
+// read columns, which must be non-null.
+using RunScreen = void (*)(const Dictionary& dict, const WordColumns* columns, const Query& q, size_t len, int d, uint64_t* mask);
+
+struct Kernel {
+    const char* name;
+    RunScreen screen_run;
+};
+
+void screen_run_scalar(const Dictionary& dict, const WordColumns*, const Query& q, size_t len, int d, uint64_t* mask)
+{
+    screen_words(dict, q, dict.words_of_length(len), d, mask);
+}
+
+#ifdef HW9_X86
+__attribute__((target("sse2")))
+void screen_run_sse2(const Dictionary& dict, const WordColumns* columns, const Query& q, size_t len, int d, uint64_t* mask)
+{
+    if (d > LANE_MAX_DISTANCE) return screen_run_scalar(dict, columns, q, len, d, mask);
+    screen_columns<Sse2Lanes>(dict, *columns, q.chars, len, d, mask);
+}
+
+__attribute__((target("avx2")))
+void screen_run_avx2(const Dictionary& dict, const WordColumns* columns, const Query& q, size_t len, int d, uint64_t* mask)
+{
+    if (d > LANE_MAX_DISTANCE) return screen_run_scalar(dict, columns, q, len, d, mask);
+    screen_columns<Avx2Lanes>(dict, *columns, q.chars, len, d, mask);
+}
+#endif
+
+const Kernel SCALAR_KERNEL{"scalar", screen_run_scalar};
+#ifdef HW9_X86
+const Kernel SSE2_KERNEL{"sse2", screen_run_sse2};
+const Kernel AVX2_KERNEL{"avx2", screen_run_avx2};
+#endif
+
+const Kernel* supported_kernel(const string& name)
+{
+    if (name == "scalar") return &SCALAR_KERNEL;
+#ifdef HW9_X86
+    __builtin_cpu_init();
+    if (name == "sse2" && __builtin_cpu_supports("sse2")) return &SSE2_KERNEL;
+    if (name == "avx2" && __builtin_cpu_supports("avx2")) return &AVX2_KERNEL;
+#endif
+    return nullptr;
+}
+
+const Kernel* pick_kernel()
+{
+    for (const char* name : {"avx2", "sse2"})
+        if (const Kernel* k = supported_kernel(name)) return k;
+    return &SCALAR_KERNEL;
+}
+
+const Kernel* active_kernel = pick_kernel();
+
+}
+
+
+bool levenshtein_within(string_view a, string_view b, int d)
+{
+    if (a.size() > b.size()) swap(a, b);
+    if (d < 0 || b.size() - a.size() > static_cast<size_t>(d)) return false;
+
+    // a shared prefix or suffix never changes the distance
+    while (!a.empty() && a.front() == b.front()) { a.remove_prefix(1); b.remove_prefix(1); }
+    while (!a.empty() && a.back() == b.back()) { a.remove_suffix(1); b.remove_suffix(1); }
+
+    int n = a.size(), m = b.size();
+    if (n == 0) return m <= d;
+
+    // only cells with |i - j| <= d can stay within d; everything else is capped at d + 1
+    const int cap = d + 1;
+    thread_local vector<int> prev, curr;
+    prev.assign(m + 1, cap);
+    curr.assign(m + 1, cap);
+    for (int j = 0; j <= min(m, d); ++j) prev[j] = j;
+
+    for (int i = 1; i <= n; ++i) {
+        int lo = max(1, i - d), hi = min(m, i + d);
+        curr[lo - 1] = (lo == 1) ? min(i, cap) : cap;
+        int row_min = curr[lo - 1];
+        for (int j = lo; j <= hi; ++j) {
+            int best = min(prev[j - 1] + (a[i - 1] != b[j - 1]), curr[j - 1] + 1);
+            if (j < i + d) best = min(best, prev[j] + 1);
+            curr[j] = min(best, cap);
+            row_min = min(row_min, curr[j]);
+        }
+        if (hi < m) curr[hi + 1] = cap;
+        if (row_min > d) return false;
+        swap(prev, curr);
+    }
+    return prev[m] <= d;
+}
+
+
+const char* edit_distance_kernel()
+{
+    return active_kernel->name;
+}
+
+
+bool use_edit_distance_kernel(const string& name)
+{
+    const Kernel* k = supported_kernel(name);
+    if (k) active_kernel = k;
+    return k != nullptr;
+}
+
+
+vector<uint64_t> edit_distance_within_batch(const Dictionary& dict, string_view query, span<const int> candidates, int d)
+{
+    vector<uint64_t> mask((candidates.size() + 63) / 64, 0);
+    if (d < 0) return mask;
+    screen_words(dict, Query(query), candidates, d, mask.data());
+    return mask;
+}
+
+
+namespace {
+
+// only lengths within d of the query can match; each length is one contiguous run
+size_t shortest_within(string_view query, int d)
+{
+    return query.size() > static_cast<size_t>(d) ? query.size() - d : 0;
+}
+
+}
+
+
+void build_word_columns(const Dictionary& dict, WordColumns& columns)
+{
+    size_t lengths = dict.length_start.empty() ? 0 : dict.length_start.size() - 1;
+    columns.start.assign(lengths + 1, 0);
+    for (size_t len = 0; len < lengths; ++len) {
+        size_t blocks = (dict.words_of_length(len).size() + WORD_COLUMN_LANES - 1) / WORD_COLUMN_LANES;
+        columns.start[len + 1] = columns.start[len] + blocks * WORD_COLUMN_LANES * len;
+    }
+    columns.chars.assign(columns.start.back(), '\0');
+    for (size_t len = 1; len < lengths; ++len) {
+        span<const int> run = dict.words_of_length(len);
+        for (size_t k = 0; k < run.size(); ++k) {
+            char* block = columns.chars.data() + columns.start[len] + k / WORD_COLUMN_LANES * WORD_COLUMN_LANES * len;
+            string_view w = dict.word(run[k]);
+            for (size_t i = 0; i < len; ++i) block[i * WORD_COLUMN_LANES + k % WORD_COLUMN_LANES] = w[i];
+        }
+    }
+}
+
+
+vector<int> words_within(const Dictionary& dict, string_view query, int d, const WordColumns* columns)
+{
+    if (d < 0) return {};
+    if (columns && columns->start.size() != max<size_t>(dict.length_start.size(), 1))
+        throw runtime_error("Word columns do not match the dictionary");
+    const Kernel* kernel = columns ? active_kernel : &SCALAR_KERNEL;
+    Query q(query);
+    vector<int> res;
+    vector<uint64_t> mask;
+
+    for (size_t len = shortest_within(query, d); len <= query.size() + d; ++len) {
+        span<const int> run = dict.words_of_length(len);
+        mask.assign((run.size() + 63) / 64, 0);
+        kernel->screen_run(dict, columns, q, len, d, mask.data());
+        for (size_t w = 0; w < mask.size(); ++w)
+            for (uint64_t bits = mask[w]; bits; bits &= bits - 1)
+                res.push_back(run[w * 64 + countr_zero(bits)]);
+    }
+
+    sort(res.begin(), res.end());
+    return res;
+}
+
+
+size_t words_within_candidates(const Dictionary& dict, string_view query, int d)
+{
+    if (d < 0) return 0;
+    size_t count = 0;
+    for (size_t len = shortest_within(query, d); len <= query.size() + d; ++len)
+        count += dict.words_of_length(len).size();
+    return count;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "dictionary.h"
+
+// Banded Levenshtein check, exact for any d.
+bool levenshtein_within(string_view a, string_view b, int d);
+
+// Words per transposed block in WordColumns, one per vector lane.
+constexpr size_t WORD_COLUMN_LANES = 32;
+
+// A dictionary's same-length runs again, transposed in blocks of
+// WORD_COLUMN_LANES words: byte i * WORD_COLUMN_LANES + k of a block is
+// character i of its k-th word, so one vector load reads the same position
+// of many words. Blocks of length L start at chars[start[L]]; unused lanes
+// are zero. Costs about as much memory as Dictionary::chars, so only callers
+// that screen many queries build one.
+struct WordColumns {
+    string chars;
+    vector<size_t> start;
+};
+
+void build_word_columns(const Dictionary& dict, WordColumns& columns);
+
+// Kernel words_within uses when given WordColumns: "avx2" and "sse2" screen
+// 32 or 16 same-length words per instruction, "scalar" checks one word at a
+// time. The best one the CPU supports is picked at startup.
+const char* edit_distance_kernel();
+
+// Switches kernels (for tests and benchmarks); false if the CPU lacks it.
+// Not thread-safe: call before issuing queries.
+bool use_edit_distance_kernel(const string& name);
+
+// Screens one query against many dictionary words, one at a time since the
+// candidates are arbitrary. Bit i % 64 of word i / 64 is set iff
+// candidates[i] is within edit distance d of query.
+vector<uint64_t> edit_distance_within_batch(const Dictionary& dict, string_view query, span<const int> candidates, int d);
+
+// Every dictionary word within edit distance d of query, in id order.
+// Without columns (built from dict) every word is checked one at a time.
+vector<int> words_within(const Dictionary& dict, string_view query, int d, const WordColumns* columns = nullptr);
+// How many words words_within(dict, query, d) compares query against.
+size_t words_within_candidates(const Dictionary& dict, string_view query, int d);
@@ -0,0 +1,34 @@
+#include "contraction_hierarchy.h"
+#include "graph_io.h"
+
+// Converts a text edge list into the binary CSR format MappedGraph opens,
+// or with --ch into a contraction hierarchy for ch_shortest_path.
+int main(int argc, char* argv[])
+{
+    bool ch = argc == 4 && string(argv[1]) == "--ch";
+    if (argc != 3 && !ch) {
+        cerr << "usage: " << argv[0] << " [--ch] <edges.txt> <output>" << endl;
+        return 1;
+    }
+    const char* input = argv[argc - 2];
+    const char* output = argv[argc - 1];
+
+    try {
+        CSRGraph g;
+        mmap_file_to_graph(input, g);
+        if (ch) {
+            ContractionHierarchy hierarchy;
+            build_contraction_hierarchy(g, hierarchy);
+            save_contraction_hierarchy(hierarchy, output);
+            cout << "Wrote " << g.numVertices << " vertices and " << hierarchy.up.size() + hierarchy.down.size()
+                 << " hierarchy arcs to " << output << endl;
+        } else {
+            save_binary_graph(g, output);
+            cout << "Wrote " << g.numVertices << " vertices and " << g.arcs.size() << " edges to " << output << endl;
+        }
+    } catch (const exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
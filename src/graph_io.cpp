@@ -0,0 +1,248 @@
+#include "graph_io.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+// Maps a whole file read-only; throws if it can't be opened or is empty.
+void* map_file(const string& filename, size_t& length)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw runtime_error("Can't open input file");
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        throw runtime_error("Unable to find input file");
+    }
+    length = st.st_size;
+    void* data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+        throw runtime_error("Can't map input file");
+    return data;
+}
+
+// Unmaps on scope exit.
+struct Mapping {
+    void* data;
+    size_t length;
+    ~Mapping() { munmap(data, length); }
+};
+
+// Runs f(0) .. f(n - 1) on n threads and rethrows the first failure.
+template <class F>
+void run_parallel(int n, F f)
+{
+    vector<exception_ptr> errors(n);
+    auto guarded = [&](int i) {
+        try {
+            f(i);
+        } catch (...) {
+            errors[i] = current_exception();
+        }
+    };
+    vector<thread> pool;
+    for (int i = 1; i < n; ++i)
+        pool.emplace_back(guarded, i);
+    guarded(0);
+    for (thread& t : pool)
+        t.join();
+    for (exception_ptr& e : errors)
+        if (e) rethrow_exception(e);
+}
+
+const char* skip_space(const char* p, const char* end)
+{
+    while (p < end && isspace(static_cast<unsigned char>(*p))) ++p;
+    return p;
+}
+
+bool parse_int(const char*& p, const char* end, int& value)
+{
+    p = skip_space(p, end);
+    auto [next, ec] = from_chars(p, end, value);
+    if (ec != errc()) return false;
+    p = next;
+    return true;
+}
+
+// Edges of one line-aligned slice of the file. After counting, counts[v]
+// becomes the slot where this chunk's next edge out of v goes.
+struct Chunk {
+    const char* begin;
+    const char* end;
+    vector<Edge> edges;
+    vector<int> counts;
+};
+
+void parse_chunk(Chunk& c, int numVertices)
+{
+    c.counts.assign(numVertices, 0);
+    const char* p = c.begin;
+    for (;;) {
+        p = skip_space(p, c.end);
+        if (p == c.end) break;
+        Edge e;
+        if (!parse_int(p, c.end, e.src) || !parse_int(p, c.end, e.dst) || !parse_int(p, c.end, e.weight))
+            throw runtime_error("Malformed edge list");
+        if (e.src < 0 || e.src >= numVertices || e.dst < 0 || e.dst >= numVertices)
+            throw runtime_error("Edge endpoint out of range");
+        ++c.counts[e.src];
+        c.edges.push_back(e);
+    }
+}
+
+size_t arcs_offset(uint64_t numVertices)
+{
+    size_t end = sizeof(GraphFileHeader) + (numVertices + 1) * sizeof(int32_t);
+    return (end + 7) / 8 * 8;
+}
+
+}
+
+
+void mmap_file_to_graph(const string& filename, CSRGraph& G, int threads)
+{
+    size_t length;
+    void* data = map_file(filename, length);
+    Mapping file{data, length};
+    const char* begin = static_cast<const char*>(file.data);
+    const char* end = begin + file.length;
+    madvise(file.data, file.length, MADV_SEQUENTIAL);
+
+    const char* p = begin;
+    int numVertices;
+    if (!parse_int(p, end, numVertices) || numVertices < 0)
+        throw runtime_error("Unable to find input file");
+
+    // by default a chunk per hardware thread, but not so small that thread startup dominates
+    constexpr size_t MIN_CHUNK = 1 << 20;
+    int numChunks = threads;
+    if (numChunks <= 0)
+        numChunks = max<size_t>(1, min<size_t>(thread::hardware_concurrency(), (end - p) / MIN_CHUNK));
+
+    // split at newlines: edges must not span lines
+    vector<Chunk> chunks(numChunks);
+    for (int i = 0; i < numChunks; ++i) {
+        const char* cut = (i == 0) ? p : chunks[i - 1].end;
+        chunks[i].begin = cut;
+        if (i == numChunks - 1) {
+            chunks[i].end = end;
+        } else {
+            const char* target = max(cut, p + (end - p) * (i + 1) / numChunks);
+            const char* nl = static_cast<const char*>(memchr(target, '\n', end - target));
+            chunks[i].end = nl ? nl + 1 : end;
+        }
+    }
+
+    run_parallel(numChunks, [&](int i) { parse_chunk(chunks[i], numVertices); });
+
+    // offsets, then each chunk's starting slot per row; rows keep file order
+    size_t numArcs = 0;
+    for (const Chunk& c : chunks) numArcs += c.edges.size();
+    if (numArcs > static_cast<size_t>(numeric_limits<int>::max()))
+        throw runtime_error("Too many edges for CSRGraph");
+
+    G.numVertices = numVertices;
+    G.offsets.assign(numVertices + 1, 0);
+    for (int v = 0; v < numVertices; ++v) {
+        int slot = G.offsets[v];
+        for (Chunk& c : chunks) {
+            int count = c.counts[v];
+            c.counts[v] = slot;
+            slot += count;
+        }
+        G.offsets[v + 1] = slot;
+    }
+
+    G.arcs.resize(numArcs);
+    run_parallel(numChunks, [&](int i) {
+        Chunk& c = chunks[i];
+        for (const Edge& e : c.edges)
+            G.arcs[c.counts[e.src]++] = Arc{e.dst, e.weight};
+        vector<Edge>().swap(c.edges);
+    });
+}
+
+
+void save_binary_graph(const CSRGraph& G, const string& filename)
+{
+    ofstream out(filename, ios::binary);
+    if (!out)
+        throw runtime_error("Can't open output file");
+
+    GraphFileHeader header{};
+    memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic));
+    header.version = GRAPH_FILE_VERSION;
+    header.arcSize = sizeof(Arc);
+    header.numVertices = G.numVertices;
+    header.numArcs = G.arcs.size();
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(G.offsets.data()), G.offsets.size() * sizeof(int32_t));
+    size_t written = sizeof(header) + G.offsets.size() * sizeof(int32_t);
+    const char zeros[8] = {};
+    out.write(zeros, arcs_offset(G.numVertices) - written);
+    out.write(reinterpret_cast<const char*>(G.arcs.data()), G.arcs.size() * sizeof(Arc));
+    if (!out)
+        throw runtime_error("Can't write output file");
+}
+
+
+void load_binary_graph(const string& filename, CSRGraph& G)
+{
+    MappedGraph mapped(filename);
+    G.numVertices = mapped.numVertices;
+    G.offsets.assign(1, 0);
+    G.arcs.clear();
+    for (int u = 0; u < mapped.numVertices; ++u) {
+        span<const Arc> row = mapped.neighbors(u);
+        G.arcs.insert(G.arcs.end(), row.begin(), row.end());
+        G.offsets.push_back(G.arcs.size());
+    }
+}
+
+
+MappedGraph::MappedGraph(const string& filename)
+{
+    data = map_file(filename, length);
+    try {
+        GraphFileHeader header;
+        if (length < sizeof(header))
+            throw runtime_error("Not a binary graph file");
+        memcpy(&header, data, sizeof(header));
+        if (memcmp(header.magic, GRAPH_FILE_MAGIC, sizeof(header.magic)) != 0)
+            throw runtime_error("Not a binary graph file");
+        if (header.version != GRAPH_FILE_VERSION || header.arcSize != sizeof(Arc))
+            throw runtime_error("Unsupported binary graph version");
+        if (header.numVertices > static_cast<uint64_t>(numeric_limits<int>::max())
+            || header.numArcs > static_cast<uint64_t>(numeric_limits<int>::max())
+            || length != arcs_offset(header.numVertices) + header.numArcs * sizeof(Arc))
+            throw runtime_error("Truncated binary graph file");
+
+        const char* base = static_cast<const char*>(data);
+        offsets = reinterpret_cast<const int32_t*>(base + sizeof(header));
+        arcs = reinterpret_cast<const Arc*>(base + arcs_offset(header.numVertices));
+        if (offsets[0] != 0 || static_cast<uint64_t>(offsets[header.numVertices]) != header.numArcs
+            || !is_sorted(offsets, offsets + header.numVertices + 1))
+            throw runtime_error("Corrupt binary graph file");
+        numVertices = header.numVertices;
+    } catch (...) {
+        munmap(data, length);
+        throw;
+    }
+}
+
+
+MappedGraph::~MappedGraph()
+{
+    munmap(data, length);
+}
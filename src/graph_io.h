@@ -0,0 +1,56 @@
+#pragma once
+
+#include "dijkstra_heaps.h"
+#include <cstdint>
+
+// Parses the text edge-list format (vertex count, then one "src dst weight"
+// per line) from a memory-mapped file, splitting it into line-aligned chunks
+// parsed on `threads` workers (0 = one per hardware thread, fewer for small files).
+// Rows keep file order. Each chunk is parsed once, staging its edges and a
+// per-vertex count, so besides the graph it needs 12 bytes per edge plus
+// `threads` ints per vertex.
+void mmap_file_to_graph(const string& filename, CSRGraph& G, int threads = 0);
+
+// Binary CSR file, native byte order:
+//   GraphFileHeader
+//   int32 offsets[numVertices + 1]
+//   zero padding to a multiple of 8 bytes
+//   Arc arcs[numArcs]
+constexpr char GRAPH_FILE_MAGIC[8] = {'H', 'W', '9', 'C', 'S', 'R', 0, 0};
+constexpr uint32_t GRAPH_FILE_VERSION = 1;
+
+struct GraphFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t arcSize; // sizeof(Arc) of the writer
+    uint64_t numVertices;
+    uint64_t numArcs;
+};
+
+void save_binary_graph(const CSRGraph& G, const string& filename);
+void load_binary_graph(const string& filename, CSRGraph& G);
+
+// A binary graph file mapped read-only. neighbors() points straight into the
+// mapping, so opening costs no parsing of the arcs; the header, array bounds
+// and monotone offsets are checked, but arc targets are not, so the file must
+// come from save_binary_graph.
+class MappedGraph {
+public:
+    explicit MappedGraph(const string& filename);
+    ~MappedGraph();
+    MappedGraph(const MappedGraph&) = delete;
+    MappedGraph& operator=(const MappedGraph&) = delete;
+
+    int numVertices=0;
+
+    span<const Arc> neighbors(int u) const { return {arcs + offsets[u], arcs + offsets[u + 1]}; }
+
+private:
+    void* data = nullptr;
+    size_t length = 0;
+    const int32_t* offsets = nullptr;
+    const Arc* arcs = nullptr;
+};
+
+inline int num_vertices(const MappedGraph& G) { return G.numVertices; }
+inline span<const Arc> out_edges(const MappedGraph& G, int u) { return G.neighbors(u); }
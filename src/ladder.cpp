@@ -1,4 +1,6 @@
 #include "ladder.h"
+#include "edit_distance_batch.h"
+#include "ladder_index.h"
 #include <algorithm>
 #include <unordered_map>
 
@@ -13,21 +15,21 @@ void error(string word1, string word2, string msg)
 
 bool edit_distance_within(const std::string& str1, const std::string& str2, int d)
 {
-    if (abs(static_cast<int>(str1.size() - str2.size())) > d)
+    if (abs(static_cast<int>(str1.size()) - static_cast<int>(str2.size())) > d)
         return false;
         
-    // case 1 - equal length
+    // case 1 - equal length: d substitutions suffice, and for d <= 1 are the only way
     if (str1.size() == str2.size()) {
         int diff = 0;
         for (size_t i = 0; i < str1.size(); ++i) {
             if (str1[i] != str2[i]) {
                 ++diff;
                 if (diff > d)
-                    return false;
+                    return d > 1 && levenshtein_within(str1, str2, d);
             }
         }
         return diff <= d;
-    } else {
+    } else if (d == 1) {
         
         // case 2 - lengths off by 1
         const string& s = (str1.size() < str2.size()) ? str1 : str2;
@@ -48,6 +50,9 @@ bool edit_distance_within(const std::string& str1, const std::string& str2, int
         
         return diff <= d;
     }
+
+    // case 3 - anything else needs the full (banded) edit distance
+    return levenshtein_within(str1, str2, d);
 }
 
 
@@ -56,38 +61,12 @@ bool is_adjacent(const string& word1, const string& word2)
     return edit_distance_within(word1, word2, 1);
 }
 
-vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const set<string>& word_list)
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const set<string>& word_list,
+                                    SearchStats* stats)
 {
-    queue<vector<string>> ladder_queue;
-    vector<string> first_word({begin_word});
-    ladder_queue.push(first_word);
-    
-    set<string> visited;
-    visited.insert(begin_word);
-
-    while (!ladder_queue.empty()) {
-        vector<string> curr_ladder = ladder_queue.front(); // current parital ladder
-        string last_word = curr_ladder.back(); // last word in partial ladder
-        ladder_queue.pop();
-
-
-        for (const string& word : word_list) {
-            if (is_adjacent(last_word, word)) {
-                if (visited.find(word) == visited.end()) {
-                    visited.insert(word);
-                    vector<string> new_ladder = curr_ladder;
-                    new_ladder.push_back(word);
-                    
-                    if (word == end_word) return new_ladder; 
-                    
-                    ladder_queue.push(new_ladder);
-                }
-            }
-            
-        }
-    }
-    
-    return {};
+    Dictionary dict;
+    build_dictionary(word_list, dict);
+    return generate_word_ladder(begin_word, end_word, move(dict), stats);
 }
 
 
@@ -115,17 +94,19 @@ void print_word_ladder(const vector<string>& ladder)
 
 void verify_word_ladder()
 {
-    set<string> word_list;
-    load_words(word_list, "words.txt");
-    my_assert(generate_word_ladder("cat", "dog", word_list).size() == 4);
+    Dictionary dict;
+    load_words(dict, "words.txt");
+    WordIndex index;
+    build_word_index(move(dict), index);
+    my_assert(generate_word_ladder("cat", "dog", index).size() == 4);
 
-    my_assert(generate_word_ladder("marty", "curls", word_list).size() == 6);
+    my_assert(generate_word_ladder("marty", "curls", index).size() == 6);
 
-    my_assert(generate_word_ladder("code", "data", word_list).size() == 6);
+    my_assert(generate_word_ladder("code", "data", index).size() == 6);
 
-    my_assert(generate_word_ladder("work", "play", word_list).size() == 6);
+    my_assert(generate_word_ladder("work", "play", index).size() == 6);
 
-    my_assert(generate_word_ladder("awake", "sleep", word_list).size() == 8);
+    my_assert(generate_word_ladder("awake", "sleep", index).size() == 8);
 
 }
 
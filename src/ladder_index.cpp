@@ -0,0 +1,333 @@
+#include "ladder_index.h"
+#include "edit_distance_batch.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace {
+
+// Hash of a word with position pos replaced by a wildcard. Two words of the
+// same length land in the same bucket for pos iff they agree everywhere else.
+uint64_t wildcard_hash(string_view word, size_t pos)
+{
+    uint64_t h = FNV_OFFSET_BASIS ^ (word.size() << 16 | pos);
+    for (size_t i = 0; i < word.size(); ++i) {
+        h ^= (i == pos) ? 0x100u : static_cast<unsigned char>(word[i]);
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+bool same_except(string_view a, string_view b, size_t pos)
+{
+    return a.size() == b.size()
+        && a.substr(0, pos) == b.substr(0, pos)
+        && a.substr(pos + 1) == b.substr(pos + 1);
+}
+
+struct Bucket {
+    uint64_t hash;
+    int pos;
+    int id;
+    bool operator<(const Bucket& other) const { return hash < other.hash; }
+};
+
+}
+
+
+void build_word_index(Dictionary dict, WordIndex& index)
+{
+    index.dict = move(dict);
+    int n = index.size();
+
+    vector<pair<int, int>> edges;
+
+    // substitutions: group words by wildcard key, then confirm each pair inside a group
+    vector<Bucket> buckets;
+    for (int i = 0; i < n; ++i)
+        for (size_t pos = 0; pos < index.dict.word(i).size(); ++pos)
+            buckets.push_back({wildcard_hash(index.dict.word(i), pos), static_cast<int>(pos), i});
+    sort(buckets.begin(), buckets.end());
+
+    for (size_t lo = 0, hi; lo < buckets.size(); lo = hi) {
+        for (hi = lo + 1; hi < buckets.size() && buckets[hi].hash == buckets[lo].hash; ++hi) {}
+        for (size_t a = lo; a < hi; ++a)
+            for (size_t b = a + 1; b < hi; ++b) {
+                const Bucket& x = buckets[a];
+                const Bucket& y = buckets[b];
+                if (x.pos == y.pos && same_except(index.dict.word(x.id), index.dict.word(y.id), x.pos)) {
+                    edges.emplace_back(x.id, y.id);
+                    edges.emplace_back(y.id, x.id);
+                }
+            }
+    }
+
+    // insertions/deletions: deleting one letter of a word yields another word
+    string deleted;
+    for (int i = 0; i < n; ++i) {
+        string_view word = index.dict.word(i);
+        for (size_t pos = 0; pos < word.size(); ++pos) {
+            if (pos > 0 && word[pos] == word[pos - 1]) continue; // same deletion as pos - 1
+            deleted.assign(word).erase(pos, 1);
+            int j = index.find(deleted);
+            if (j >= 0) {
+                edges.emplace_back(i, j);
+                edges.emplace_back(j, i);
+            }
+        }
+    }
+
+    // counting sort into CSR; ascending neighbor ids keep the set<string> visiting order
+    index.offsets.assign(n + 1, 0);
+    for (const auto& [u, v] : edges) ++index.offsets[u + 1];
+    for (int i = 0; i < n; ++i) index.offsets[i + 1] += index.offsets[i];
+    index.adj.resize(edges.size());
+    vector<int> cursor(index.offsets.begin(), index.offsets.end() - 1);
+    for (const auto& [u, v] : edges) index.adj[cursor[u]++] = v;
+
+    int out = 0;
+    for (int i = 0; i < n; ++i) {
+        auto first = index.adj.begin() + index.offsets[i];
+        auto last = index.adj.begin() + index.offsets[i + 1];
+        sort(first, last);
+        last = unique(first, last);
+        index.offsets[i] = out;
+        for (auto it = first; it != last; ++it) index.adj[out++] = *it;
+    }
+    index.offsets[n] = out;
+    index.adj.resize(out);
+    index.adj.shrink_to_fit();
+}
+
+
+void build_word_index(const set<string>& word_list, WordIndex& index)
+{
+    Dictionary dict;
+    build_dictionary(word_list, dict);
+    build_word_index(move(dict), index);
+}
+
+
+vector<int> adjacent_words(const WordIndex& index, const string& word)
+{
+    int id = index.find(word);
+    if (id >= 0) {
+        span<const int> nbrs = index.neighbors(id);
+        return vector<int>(nbrs.begin(), nbrs.end());
+    }
+
+    // not in the dictionary: one batched scan of the neighboring lengths
+    return words_within(index.dict, word, 1);
+}
+
+
+namespace {
+
+constexpr int UNSEEN = -2; // parent -1 means "reached from the search root"
+
+// Walks parent pointers from id back to the root, root first.
+vector<string> ladder_to(const WordIndex& index, const vector<int>& parent, int id)
+{
+    vector<string> ladder;
+    for (int curr = id; curr != -1; curr = parent[curr])
+        ladder.push_back(string(index.dict.word(curr)));
+    reverse(ladder.begin(), ladder.end());
+    return ladder;
+}
+
+vector<string> forward_ladder(const string& begin_word, int start, int target, const WordIndex& index,
+                              SearchStats& stats, PhaseTimer& timer)
+{
+    vector<int> parent(index.size(), UNSEEN);
+    queue<int> ladder_queue;
+    HW9_COUNT(stats.bytes_allocated += index.size() * sizeof(int));
+
+    if (start >= 0) {
+        parent[start] = -1;
+        ladder_queue.push(start);
+    } else {
+        HW9_COUNT(stats.adjacency_checks += words_within_candidates(index.dict, begin_word, 1));
+        for (int word : adjacent_words(index, begin_word)) {
+            parent[word] = -1;
+            ladder_queue.push(word);
+        }
+    }
+    HW9_COUNT(stats.heap_pushes = stats.queue_peak = ladder_queue.size());
+    timer.lap(stats.setup_time);
+
+    while (!ladder_queue.empty() && parent[target] == UNSEEN) {
+        int last_word = ladder_queue.front();
+        ladder_queue.pop();
+        HW9_COUNT(++stats.vertices_settled);
+
+        for (int word : index.neighbors(last_word)) {
+            if (parent[word] == UNSEEN) {
+                parent[word] = last_word;
+                HW9_COUNT(++stats.edges_relaxed);
+                if (word == target) break;
+                ladder_queue.push(word);
+                HW9_COUNT(++stats.heap_pushes);
+            }
+        }
+        HW9_COUNT(stats.queue_peak = max<uint64_t>(stats.queue_peak, ladder_queue.size()));
+    }
+    timer.lap(stats.search_time);
+
+    if (parent[target] == UNSEEN) return {};
+
+    vector<string> ladder = ladder_to(index, parent, target);
+    if (start < 0) ladder.insert(ladder.begin(), begin_word);
+    timer.lap(stats.path_time);
+    return ladder;
+}
+
+// Per-thread state of bidirectional_ladder. dist is -1 for words the current
+// search hasn't reached; prepare resets only the words the last search
+// touched, so a query costs its search space rather than the dictionary size.
+struct BidirectionalScratch {
+    vector<int> parent[2];
+    vector<int> dist[2];
+    vector<int> touched; // words either side has reached
+    vector<int> frontier[2];
+    vector<int> next;
+
+    // Returns the bytes it had to allocate, 0 once warmed up for this size.
+    size_t prepare(int numWords)
+    {
+        size_t allocated = 0;
+        if (static_cast<int>(dist[0].size()) != numWords) {
+            for (int side : {0, 1}) {
+                parent[side].assign(numWords, UNSEEN);
+                dist[side].assign(numWords, -1);
+            }
+            touched.clear();
+            allocated = 4 * numWords * sizeof(int);
+        }
+        for (int id : touched) dist[0][id] = dist[1][id] = -1;
+        touched.clear();
+        frontier[0].clear();
+        frontier[1].clear();
+        next.clear();
+        return allocated;
+    }
+
+    void reach(int side, int id, int d, int from)
+    {
+        if (dist[0][id] < 0 && dist[1][id] < 0) touched.push_back(id);
+        dist[side][id] = d;
+        parent[side][id] = from;
+    }
+};
+
+// Level-synchronous search from both ends. When a level of one side first
+// touches the other side, the cheapest crossing edge of that level is a
+// shortest ladder.
+vector<string> bidirectional_ladder(const string& begin_word, const string& end_word, int start, int target, const WordIndex& index,
+                                    SearchStats& stats, PhaseTimer& timer)
+{
+    thread_local BidirectionalScratch scratch;
+    [[maybe_unused]] size_t allocated = scratch.prepare(index.size());
+    HW9_COUNT(stats.bytes_allocated += allocated);
+    vector<int>* parent = scratch.parent;
+    vector<int>* dist = scratch.dist;
+    vector<int>* frontier = scratch.frontier;
+    vector<int>& next = scratch.next;
+
+    if (start >= 0) {
+        scratch.reach(0, start, 0, -1);
+        frontier[0].push_back(start);
+    } else {
+        HW9_COUNT(stats.adjacency_checks += words_within_candidates(index.dict, begin_word, 1));
+        for (int word : adjacent_words(index, begin_word)) {
+            if (word == target) return {begin_word, end_word};
+            scratch.reach(0, word, 1, -1);
+            frontier[0].push_back(word);
+        }
+    }
+    scratch.reach(1, target, 0, -1);
+    frontier[1].push_back(target);
+    HW9_COUNT(stats.heap_pushes = frontier[0].size() + 1);
+    HW9_COUNT(stats.queue_peak = frontier[0].size());
+    timer.lap(stats.setup_time);
+
+    while (!frontier[0].empty() && !frontier[1].empty()) {
+        int side = frontier[0].size() <= frontier[1].size() ? 0 : 1;
+        int other = 1 - side;
+        int best = numeric_limits<int>::max(), meet_from = -1, meet_to = -1;
+        next.clear();
+
+        for (int u : frontier[side]) {
+            HW9_COUNT(++stats.vertices_settled);
+            for (int v : index.neighbors(u)) {
+                if (dist[other][v] >= 0 && dist[side][u] + 1 + dist[other][v] < best) {
+                    best = dist[side][u] + 1 + dist[other][v];
+                    meet_from = u;
+                    meet_to = v;
+                }
+                if (dist[side][v] < 0) {
+                    scratch.reach(side, v, dist[side][u] + 1, u);
+                    next.push_back(v);
+                    HW9_COUNT(++stats.edges_relaxed);
+                }
+            }
+        }
+        HW9_COUNT(stats.heap_pushes += next.size());
+        HW9_COUNT(stats.queue_peak = max<uint64_t>(stats.queue_peak, next.size()));
+
+        if (meet_from >= 0) {
+            timer.lap(stats.search_time);
+            int front = side == 0 ? meet_from : meet_to;
+            int back = side == 0 ? meet_to : meet_from;
+            vector<string> ladder = ladder_to(index, parent[0], front);
+            if (start < 0) ladder.insert(ladder.begin(), begin_word);
+            for (int curr = back; curr != -1; curr = parent[1][curr])
+                ladder.push_back(string(index.dict.word(curr)));
+            timer.lap(stats.path_time);
+            return ladder;
+        }
+        frontier[side].swap(next);
+    }
+    timer.lap(stats.search_time);
+    return {};
+}
+
+vector<string> search_ladder(const string& begin_word, const string& end_word, const WordIndex& index,
+                             LadderSearch mode, SearchStats& stats, PhaseTimer& timer)
+{
+    int target = index.find(end_word);
+    if (target < 0 || begin_word == end_word) return {};
+
+    int start = index.find(begin_word);
+    if (mode == LadderSearch::Forward)
+        return forward_ladder(begin_word, start, target, index, stats, timer);
+    return bidirectional_ladder(begin_word, end_word, start, target, index, stats, timer);
+}
+
+}
+
+
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const WordIndex& index,
+                                    LadderSearch mode, SearchStats* stats)
+{
+    SearchStats local;
+    PhaseTimer timer;
+    vector<string> ladder = search_ladder(begin_word, end_word, index, mode, local, timer);
+    report_search_stats(SearchEngine::WordLadder, local, stats);
+    return ladder;
+}
+
+
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, Dictionary dict,
+                                    SearchStats* stats)
+{
+    SearchStats local;
+    PhaseTimer timer;
+    WordIndex index;
+    build_word_index(move(dict), index);
+    HW9_COUNT(local.bytes_allocated = (index.offsets.size() + index.adj.size()) * sizeof(int));
+    timer.lap(local.setup_time);
+
+    vector<string> ladder = search_ladder(begin_word, end_word, index, LadderSearch::Bidirectional, local, timer);
+    report_search_stats(SearchEngine::WordLadder, local, stats);
+    return ladder;
+}
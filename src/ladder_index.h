@@ -0,0 +1,33 @@
+#pragma once
+
+#include "dictionary.h"
+#include <span>
+
+// Edit-distance-1 adjacency index over a dictionary. Every word id keeps its
+// neighbor ids, so a ladder search visits only real neighbors instead of
+// rescanning the dictionary. Build once, query many times.
+struct WordIndex {
+    Dictionary dict;
+    vector<int> offsets; // neighbors of id i are adj[offsets[i], offsets[i+1])
+    vector<int> adj;
+
+    int size() const { return dict.size(); }
+    int find(string_view word) const { return dict.find(word); }
+    span<const int> neighbors(int id) const
+    {
+        return span<const int>(adj).subspan(offsets[id], offsets[id + 1] - offsets[id]);
+    }
+};
+
+// Forward grows one BFS from begin_word; Bidirectional grows from both ends,
+// always expanding the smaller frontier. Both return a shortest ladder.
+enum class LadderSearch { Forward, Bidirectional };
+
+void build_word_index(Dictionary dict, WordIndex& index);
+void build_word_index(const set<string>& word_list, WordIndex& index);
+vector<int> adjacent_words(const WordIndex& index, const string& word);
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const WordIndex& index,
+                                    LadderSearch mode = LadderSearch::Bidirectional, SearchStats* stats = nullptr);
+// Builds a one-off index; its stats charge the build to setup_time.
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, Dictionary dict,
+                                    SearchStats* stats = nullptr);
@@ -0,0 +1,184 @@
+#include "ladder_oracle.h"
+#include "binary_io.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// Breadth-first distances from root; -1 outside root's component.
+void bfs_distances(const WordIndex& index, int root, vector<int>& dist)
+{
+    dist.assign(index.size(), -1);
+    vector<int> queue = {root};
+    dist[root] = 0;
+    for (size_t i = 0; i < queue.size(); ++i)
+        for (int v : index.neighbors(queue[i]))
+            if (dist[v] < 0) {
+                dist[v] = dist[queue[i]] + 1;
+                queue.push_back(v);
+            }
+}
+
+// FNV-1a over the hash of every word in id order, so word boundaries count.
+uint64_t hash_words(const WordIndex& index)
+{
+    uint64_t h = FNV_OFFSET_BASIS;
+    for (int id = 0; id < index.size(); ++id) {
+        h ^= hash_word(index.dict.word(id));
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+}
+
+
+int LadderOracle::lower_bound(int a, int b) const
+{
+    size_t k = landmarks.size();
+    const uint8_t* da = distances.data() + a * k;
+    const uint8_t* db = distances.data() + b * k;
+    int bound = 0;
+    for (size_t l = 0; l < k; ++l)
+        if (da[l] != LANDMARK_UNREACHED && db[l] != LANDMARK_UNREACHED)
+            bound = max(bound, abs(da[l] - db[l]));
+    return bound;
+}
+
+
+void build_ladder_oracle(const WordIndex& index, LadderOracle& oracle, int num_landmarks)
+{
+    int n = index.size();
+    oracle.component.assign(n, -1);
+    oracle.numComponents = 0;
+    vector<int> component_size;
+    vector<int> queue;
+    for (int root = 0; root < n; ++root) {
+        if (oracle.component[root] >= 0) continue;
+        int c = oracle.numComponents++;
+        oracle.component[root] = c;
+        queue.assign(1, root);
+        for (size_t i = 0; i < queue.size(); ++i)
+            for (int v : index.neighbors(queue[i]))
+                if (oracle.component[v] < 0) {
+                    oracle.component[v] = c;
+                    queue.push_back(v);
+                }
+        component_size.push_back(queue.size());
+    }
+
+    // Landmarks all go to the largest component, where searches are long.
+    // The first is its best-connected hub; each next one is the word farthest
+    // from the landmarks so far, since bounds are tightest from the edges.
+    oracle.landmarks.clear();
+    oracle.distances.clear();
+    if (n == 0) return;
+    int largest = max_element(component_size.begin(), component_size.end()) - component_size.begin();
+    num_landmarks = min(num_landmarks, component_size[largest]);
+
+    auto degree = [&](int id) { return index.neighbors(id).size(); };
+    int next = -1;
+    for (int id = 0; id < n; ++id)
+        if (oracle.component[id] == largest && (next < 0 || degree(id) > degree(next)))
+            next = id;
+
+    vector<int> nearest(n, numeric_limits<int>::max()); // distance to the closest landmark
+    vector<vector<int>> dist(num_landmarks);
+    for (int l = 0; l < num_landmarks; ++l) {
+        oracle.landmarks.push_back(next);
+        bfs_distances(index, next, dist[l]);
+        next = -1;
+        for (int id = 0; id < n; ++id) {
+            if (dist[l][id] < 0) continue;
+            nearest[id] = min(nearest[id], dist[l][id]);
+            if (next < 0 || nearest[id] > nearest[next] || (nearest[id] == nearest[next] && degree(id) > degree(next)))
+                next = id;
+        }
+    }
+
+    oracle.distances.resize(static_cast<size_t>(n) * num_landmarks);
+    for (int id = 0; id < n; ++id)
+        for (int l = 0; l < num_landmarks; ++l)
+            oracle.distances[static_cast<size_t>(id) * num_landmarks + l] =
+                dist[l][id] < 0 ? LANDMARK_UNREACHED : min(dist[l][id], LANDMARK_MAX_DISTANCE);
+}
+
+
+void save_ladder_oracle(const WordIndex& index, const LadderOracle& oracle, const string& filename)
+{
+    if (oracle.size() != index.size())
+        throw runtime_error("Ladder oracle does not match the word index");
+    ofstream out(filename, ios::binary);
+    if (!out)
+        throw runtime_error("Can't open output file");
+
+    LadderOracleHeader header{};
+    memcpy(header.magic, LADDER_ORACLE_MAGIC, sizeof(header.magic));
+    header.version = LADDER_ORACLE_VERSION;
+    header.numLandmarks = oracle.landmarks.size();
+    header.numWords = oracle.size();
+    header.numComponents = oracle.numComponents;
+    header.wordsHash = hash_words(index);
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    write_array(out, oracle.component);
+    write_array(out, oracle.landmarks);
+    write_array(out, oracle.distances);
+    if (!out)
+        throw runtime_error("Can't write output file");
+}
+
+
+void load_ladder_oracle(const string& filename, const WordIndex& index, LadderOracle& oracle)
+{
+    ifstream in(filename, ios::binary);
+    if (!in)
+        throw runtime_error("Can't open input file");
+
+    LadderOracleHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || memcmp(header.magic, LADDER_ORACLE_MAGIC, sizeof(header.magic)) != 0)
+        throw runtime_error("Not a ladder oracle file");
+    if (header.version != LADDER_ORACLE_VERSION)
+        throw runtime_error("Unsupported ladder oracle version");
+    if (header.numWords != static_cast<uint64_t>(index.size()) || header.wordsHash != hash_words(index))
+        throw runtime_error("Ladder oracle was built for a different dictionary");
+    if (header.numComponents > header.numWords || header.numLandmarks > header.numWords)
+        throw runtime_error("Corrupt ladder oracle file");
+
+    int n = index.size();
+    oracle.numComponents = header.numComponents;
+    read_array(in, oracle.component, n);
+    read_array(in, oracle.landmarks, header.numLandmarks);
+    read_array(in, oracle.distances, static_cast<size_t>(n) * header.numLandmarks);
+    if (!in || in.peek() != EOF)
+        throw runtime_error("Truncated ladder oracle file");
+    for (int c : oracle.component)
+        if (c < 0 || c >= oracle.numComponents)
+            throw runtime_error("Corrupt ladder oracle file");
+    for (int id : oracle.landmarks)
+        if (id < 0 || id >= n)
+            throw runtime_error("Corrupt ladder oracle file");
+}
+
+
+
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const WordIndex& index,
+                                    const LadderOracle& oracle, SearchStats* stats)
+{
+    if (oracle.size() != index.size())
+        throw runtime_error("Ladder oracle does not match the word index");
+
+    // a begin word outside the dictionary would need its neighbors looked up
+    // first, which is most of what the search itself costs; let it decide
+    int start = index.find(begin_word), target = index.find(end_word);
+    if (start < 0 || target < 0 || oracle.connected(start, target))
+        return generate_word_ladder(begin_word, end_word, index, LadderSearch::Bidirectional, stats);
+
+    SearchStats local;
+    PhaseTimer timer;
+    timer.lap(local.setup_time);
+    report_search_stats(SearchEngine::WordLadder, local, stats);
+    return {};
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ladder_index.h"
+#include <cstdint>
+
+// Precomputed facts about a WordIndex graph: the connected component of
+// every word, so impossible pairs are rejected without a search, and BFS
+// distances from a few landmark words, which give the lower bound
+//   d(a, b) >= |d(L, a) - d(L, b)|   for every landmark L
+// on the length of any ladder between two words.
+constexpr uint8_t LANDMARK_UNREACHED = 255; // landmark in another component
+constexpr int LANDMARK_MAX_DISTANCE = 254;  // longer distances are stored capped
+
+struct LadderOracle {
+    vector<int> component;      // word id -> connected component id
+    int numComponents=0;
+    vector<int> landmarks;      // word ids
+    vector<uint8_t> distances;  // distances[id * landmarks.size() + l]: landmark l to word id
+
+    int size() const { return component.size(); }
+    bool connected(int a, int b) const { return component[a] == component[b]; }
+    int lower_bound(int a, int b) const;
+};
+
+void build_ladder_oracle(const WordIndex& index, LadderOracle& oracle, int num_landmarks = 8);
+
+// Binary oracle file, native byte order:
+//   LadderOracleHeader
+//   int32 component[numWords]
+//   int32 landmarks[numLandmarks]
+//   uint8 distances[numWords * numLandmarks]
+// wordsHash ties the file to the dictionary it was built from.
+constexpr char LADDER_ORACLE_MAGIC[8] = {'H', 'W', '9', 'L', 'A', 'D', 'R', 0};
+constexpr uint32_t LADDER_ORACLE_VERSION = 2;
+
+struct LadderOracleHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t numLandmarks;
+    uint64_t numWords;
+    uint64_t numComponents;
+    uint64_t wordsHash;
+};
+
+void save_ladder_oracle(const WordIndex& index, const LadderOracle& oracle, const string& filename);
+void load_ladder_oracle(const string& filename, const WordIndex& index, LadderOracle& oracle);
+
+// Returns {} at once when both words are in the dictionary but in different
+// components; otherwise the bidirectional search of the other overloads.
+vector<string> generate_word_ladder(const string& begin_word, const string& end_word, const WordIndex& index,
+                                    const LadderOracle& oracle, SearchStats* stats = nullptr);
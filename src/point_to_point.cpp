@@ -0,0 +1,127 @@
+#include "point_to_point.h"
+#include <algorithm>
+
+void reverse_graph(const CSRGraph& G, CSRGraph& reversed)
+{
+    vector<Edge> edges;
+    edges.reserve(G.arcs.size());
+    for (int u = 0; u < G.numVertices; ++u)
+        for (const Arc& a : G.neighbors(u))
+            edges.emplace_back(a.dst, u, a.weight);
+    build_csr_graph(G.numVertices, edges, reversed);
+}
+
+void build_bidirectional_graph(CSRGraph G, BidirectionalGraph& B)
+{
+    reverse_graph(G, B.backward);
+    B.forward = move(G);
+}
+
+void file_to_graph(const string& filename, BidirectionalGraph& B)
+{
+    CSRGraph G;
+    file_to_graph(filename, G);
+    build_bidirectional_graph(move(G), B);
+}
+
+int dijkstra_point_to_point(const CSRGraph& G, int source, int destination, vector<int>& path, SearchStats* stats)
+{
+    SearchStats local;
+    PhaseTimer timer;
+    vector<int> distances(G.numVertices, INF);
+    vector<int> previous(G.numVertices, -1);
+    distances[source] = 0;
+
+    FourAryHeap pq;
+    pq.reset(G.numVertices);
+    pq.push(source, 0);
+    HW9_COUNT(local.heap_pushes = 1);
+    timer.lap(local.setup_time);
+
+    while (!pq.empty()) {
+        HW9_COUNT(local.queue_peak = max<uint64_t>(local.queue_peak, pq.size()));
+        int u = pq.pop();
+        if (u == destination) break;
+        HW9_COUNT(++local.vertices_settled);
+
+        for (const Arc& a : G.neighbors(u)) {
+            int v = a.dst, d = distances[u] + a.weight;
+            if (d < distances[v]) {
+                distances[v] = d;
+                previous[v] = u;
+                pq.push(v, d);
+                HW9_COUNT(++local.edges_relaxed);
+                HW9_COUNT(++local.heap_pushes);
+            }
+        }
+    }
+    timer.lap(local.search_time);
+    HW9_COUNT(local.bytes_allocated = 2 * G.numVertices * sizeof(int) + pq.bytes());
+
+    path.clear();
+    if (distances[destination] != INF) path = extract_shortest_path(distances, previous, destination);
+    timer.lap(local.path_time);
+    report_search_stats(SearchEngine::Dijkstra, local, stats);
+    return distances[destination];
+}
+
+int bidirectional_dijkstra(const BidirectionalGraph& B, int source, int destination, vector<int>& path, SearchStats* stats)
+{
+    SearchStats local;
+    PhaseTimer timer;
+    int numVert = B.forward.numVertices;
+    const CSRGraph* graph[2] = {&B.forward, &B.backward};
+    vector<int> distances[2] = {vector<int>(numVert, INF), vector<int>(numVert, INF)};
+    vector<int> previous[2] = {vector<int>(numVert, -1), vector<int>(numVert, -1)};
+    FourAryHeap pq[2];
+
+    for (int side : {0, 1}) {
+        int root = side == 0 ? source : destination;
+        distances[side][root] = 0;
+        pq[side].reset(numVert);
+        pq[side].push(root, 0);
+    }
+    HW9_COUNT(local.heap_pushes = 2);
+    timer.lap(local.setup_time);
+
+    // best = distances[0][meet] + distances[1][meet] over vertices reached from both ends
+    int best = source == destination ? 0 : INF;
+    int meet = source == destination ? source : -1;
+
+    while (!pq[0].empty() && !pq[1].empty()) {
+        if (best != INF && pq[0].top_key() + pq[1].top_key() >= best) break;
+
+        HW9_COUNT(local.queue_peak = max<uint64_t>(local.queue_peak, pq[0].size() + pq[1].size()));
+        int side = pq[0].top_key() <= pq[1].top_key() ? 0 : 1;
+        int other = 1 - side;
+        int u = pq[side].pop();
+        HW9_COUNT(++local.vertices_settled);
+
+        for (const Arc& a : graph[side]->neighbors(u)) {
+            int v = a.dst, d = distances[side][u] + a.weight;
+            if (d < distances[side][v]) {
+                distances[side][v] = d;
+                previous[side][v] = u;
+                pq[side].push(v, d);
+                HW9_COUNT(++local.edges_relaxed);
+                HW9_COUNT(++local.heap_pushes);
+            }
+            if (distances[other][v] != INF && distances[side][v] + distances[other][v] < best) {
+                best = distances[side][v] + distances[other][v];
+                meet = v;
+            }
+        }
+    }
+    timer.lap(local.search_time);
+    HW9_COUNT(local.bytes_allocated = 4 * numVert * sizeof(int) + pq[0].bytes() + pq[1].bytes());
+
+    path.clear();
+    if (meet >= 0) {
+        path = extract_shortest_path(distances[0], previous[0], meet);
+        for (int curr = previous[1][meet]; curr != -1; curr = previous[1][curr])
+            path.push_back(curr);
+    }
+    timer.lap(local.path_time);
+    report_search_stats(SearchEngine::Dijkstra, local, stats);
+    return meet >= 0 ? best : INF;
+}
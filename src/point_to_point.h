@@ -0,0 +1,73 @@
+#pragma once
+
+#include "dijkstra_heaps.h"
+
+// A graph together with its reverse (edges into v stored at v), for searches
+// that also grow backwards from the destination.
+struct BidirectionalGraph {
+    CSRGraph forward;
+    CSRGraph backward;
+};
+
+void reverse_graph(const CSRGraph& G, CSRGraph& reversed);
+void build_bidirectional_graph(CSRGraph G, BidirectionalGraph& B);
+void file_to_graph(const string& filename, BidirectionalGraph& B);
+
+// Each search returns the source -> destination distance (INF if unreachable)
+// and fills path with its vertices in extract_shortest_path order. They
+// report to SearchEngine::Dijkstra like dijkstra_shortest_path. Weights must
+// be non-negative; none of them checks, and a negative cycle never ends.
+
+// Dijkstra that stops as soon as destination is settled.
+int dijkstra_point_to_point(const CSRGraph& G, int source, int destination, vector<int>& path,
+                            SearchStats* stats = nullptr);
+
+// Dijkstra from both ends, stopping once the two queue minimums together
+// reach the best meeting distance found.
+int bidirectional_dijkstra(const BidirectionalGraph& B, int source, int destination, vector<int>& path,
+                           SearchStats* stats = nullptr);
+
+// A* search; heuristic(v) must never exceed the true distance from v to
+// destination. Inconsistent heuristics are fine: improved vertices are reopened.
+template <class Heuristic>
+int astar_shortest_path(const CSRGraph& G, int source, int destination, Heuristic heuristic, vector<int>& path,
+                        SearchStats* stats = nullptr)
+{
+    SearchStats local;
+    PhaseTimer timer;
+    vector<int> distances(G.numVertices, INF);
+    vector<int> previous(G.numVertices, -1);
+    distances[source] = 0;
+
+    FourAryHeap pq; // keyed by distance + heuristic
+    pq.reset(G.numVertices);
+    pq.push(source, heuristic(source));
+    HW9_COUNT(local.heap_pushes = 1);
+    timer.lap(local.setup_time);
+
+    while (!pq.empty()) {
+        HW9_COUNT(local.queue_peak = max<uint64_t>(local.queue_peak, pq.size()));
+        int u = pq.pop();
+        if (u == destination) break;
+        HW9_COUNT(++local.vertices_settled);
+
+        for (const Arc& a : G.neighbors(u)) {
+            int v = a.dst, d = distances[u] + a.weight;
+            if (d < distances[v]) {
+                distances[v] = d;
+                previous[v] = u;
+                pq.push(v, d + heuristic(v));
+                HW9_COUNT(++local.edges_relaxed);
+                HW9_COUNT(++local.heap_pushes);
+            }
+        }
+    }
+    timer.lap(local.search_time);
+    HW9_COUNT(local.bytes_allocated = 2 * G.numVertices * sizeof(int) + pq.bytes());
+
+    path.clear();
+    if (distances[destination] != INF) path = extract_shortest_path(distances, previous, destination);
+    timer.lap(local.path_time);
+    report_search_stats(SearchEngine::Dijkstra, local, stats);
+    return distances[destination];
+}
@@ -1,9 +1,9 @@
 echo "Compiling..."
 
 if [ "$1" == "ladder" ]; then
-    g++ -o output ladder.cpp dijkstras.cpp ladder_main.cpp
+    g++ -std=c++20 -o output ladder.cpp dictionary.cpp edit_distance_batch.cpp ladder_index.cpp ladder_oracle.cpp dijkstras.cpp ladder_main.cpp
 else 
-    g++ -o output dijkstras.cpp dijkstras_main.cpp
+    g++ -std=c++20 -pthread -o output dijkstras.cpp csr_graph.cpp dijkstra_engine.cpp point_to_point.cpp graph_io.cpp sssp_cache.cpp contraction_hierarchy.cpp dijkstras_main.cpp
 fi
 
 
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+using namespace std;
+
+// Searches count their work when HW9_STATS is 1 (the default). Configure
+// with -DHW9_ENABLE_STATS=OFF, or compile with -DHW9_STATS=0, to strip
+// every counter and clock read from the hot paths.
+#ifndef HW9_STATS
+#define HW9_STATS 1
+#endif
+
+// Work done by one search. A search counts into a local SearchStats and
+// publishes it once when it returns, so its loops touch no shared memory.
+struct SearchStats {
+    uint64_t queries = 0;
+    uint64_t vertices_settled = 0;  // vertices (words) taken off the queue and expanded
+    uint64_t edges_relaxed = 0;     // edges that lowered a distance or reached a new word
+    uint64_t heap_pushes = 0;       // priority-queue pushes, or ladder-queue pushes
+    uint64_t stale_pops = 0;        // pops of vertices that were already settled
+    uint64_t adjacency_checks = 0;  // edit-distance tests against candidate words
+    uint64_t queue_peak = 0;        // largest queue or frontier seen
+    uint64_t bytes_allocated = 0;   // working arrays and queue; only their growth for reused scratch
+    chrono::nanoseconds setup_time{0};  // allocating and initializing working arrays
+    chrono::nanoseconds search_time{0};
+    chrono::nanoseconds path_time{0};   // turning parent pointers into the answer
+
+    SearchStats& operator+=(const SearchStats& other)
+    {
+        queries += other.queries;
+        vertices_settled += other.vertices_settled;
+        edges_relaxed += other.edges_relaxed;
+        heap_pushes += other.heap_pushes;
+        stale_pops += other.stale_pops;
+        adjacency_checks += other.adjacency_checks;
+        queue_peak = max(queue_peak, other.queue_peak);
+        bytes_allocated += other.bytes_allocated;
+        setup_time += other.setup_time;
+        search_time += other.search_time;
+        path_time += other.path_time;
+        return *this;
+    }
+};
+
+enum class SearchEngine { Dijkstra, WordLadder };
+
+// Called on the searching thread after every search. Install it before any
+// searches start; an empty function removes it.
+using SearchStatsCallback = function<void(SearchEngine, const SearchStats&)>;
+
+namespace search_stats_detail {
+inline SearchStatsCallback callback;
+inline thread_local SearchStats totals[2];
+}
+
+inline void set_search_stats_callback(SearchStatsCallback callback)
+{
+    search_stats_detail::callback = move(callback);
+}
+
+// Sum of every search this thread has run since the last reset; lock-free
+// because each thread only ever touches its own totals.
+inline const SearchStats& thread_search_stats(SearchEngine engine)
+{
+    return search_stats_detail::totals[static_cast<int>(engine)];
+}
+
+inline void reset_thread_search_stats()
+{
+    for (SearchStats& t : search_stats_detail::totals) t = {};
+}
+
+#if HW9_STATS
+
+#define HW9_COUNT(expr) (expr)
+
+// Charges the time since the previous lap to one phase field.
+class PhaseTimer {
+public:
+    void lap(chrono::nanoseconds& phase)
+    {
+        auto now = chrono::steady_clock::now();
+        phase += now - last;
+        last = now;
+    }
+
+private:
+    chrono::steady_clock::time_point last = chrono::steady_clock::now();
+};
+
+// Publishes a finished search to the out-parameter, the thread totals and the callback.
+inline void report_search_stats(SearchEngine engine, SearchStats& stats, SearchStats* out)
+{
+    stats.queries = 1;
+    search_stats_detail::totals[static_cast<int>(engine)] += stats;
+    if (search_stats_detail::callback) search_stats_detail::callback(engine, stats);
+    if (out) *out = stats;
+}
+
+#else
+
+#define HW9_COUNT(expr) ((void)0)
+
+class PhaseTimer {
+public:
+    void lap(chrono::nanoseconds&) {}
+};
+
+inline void report_search_stats(SearchEngine, SearchStats&, SearchStats* out)
+{
+    if (out) *out = {};
+}
+
+#endif
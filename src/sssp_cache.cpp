@@ -0,0 +1,192 @@
+#include "sssp_cache.h"
+#include <algorithm>
+
+namespace {
+
+// the in-list copy of an out-edge: same endpoints and weight
+Edge& mirror(Graph& in, const Edge& e)
+{
+    return *find_if(in[e.dst].begin(), in[e.dst].end(),
+                    [&](const Edge& f) { return f.src == e.src && f.weight == e.weight; });
+}
+
+}
+
+ShortestPathCache::ShortestPathCache(const Graph& G, int capacity)
+    : out(G), capacity(max(1, capacity))
+{
+    int n = G.size();
+    out.numVertices = n;
+    in.numVertices = n;
+    in.resize(n);
+    for (const vector<Edge>& row : out)
+        for (const Edge& e : row) {
+            check_weight(e.weight);
+            in[e.dst].push_back(e);
+        }
+    pq.reset(n);
+    in_subtree.assign(n, false);
+}
+
+void ShortestPathCache::check_vertex(int v) const
+{
+    if (v < 0 || v >= static_cast<int>(out.size()))
+        throw runtime_error("Vertex out of range");
+}
+
+// the repairs, like Dijkstra, rely on no path getting cheaper by growing
+void ShortestPathCache::check_weight(int weight) const
+{
+    if (weight < 0)
+        throw runtime_error("Negative edge weight");
+}
+
+Edge& ShortestPathCache::find_edge(int u, int v)
+{
+    check_vertex(u);
+    check_vertex(v);
+    auto it = find_if(out[u].begin(), out[u].end(), [v](const Edge& e) { return e.dst == v; });
+    if (it == out[u].end())
+        throw runtime_error("No such edge");
+    return *it;
+}
+
+void ShortestPathCache::insert_edge(int u, int v, int weight)
+{
+    check_vertex(u);
+    check_vertex(v);
+    check_weight(weight);
+    out[u].emplace_back(u, v, weight);
+    in[v].emplace_back(u, v, weight);
+    for (auto& [source, t] : trees)
+        edge_decreased(t, u, v, weight);
+}
+
+void ShortestPathCache::remove_edge(int u, int v)
+{
+    Edge& e = find_edge(u, v);
+    Edge& m = mirror(in, e);
+    in[v].erase(in[v].begin() + (&m - in[v].data()));
+    out[u].erase(out[u].begin() + (&e - out[u].data()));
+    for (auto& [source, t] : trees)
+        edge_increased(t, u, v);
+}
+
+void ShortestPathCache::set_edge_weight(int u, int v, int weight)
+{
+    check_weight(weight);
+    Edge& e = find_edge(u, v);
+    int old = e.weight;
+    mirror(in, e).weight = weight;
+    e.weight = weight;
+    for (auto& [source, t] : trees) {
+        if (weight < old) edge_decreased(t, u, v, weight);
+        else if (weight > old) edge_increased(t, u, v);
+    }
+}
+
+int ShortestPathCache::distance(int source, int destination)
+{
+    check_vertex(destination);
+    return tree(source).distances[destination];
+}
+
+vector<int> ShortestPathCache::path(int source, int destination)
+{
+    check_vertex(destination);
+    const Tree& t = tree(source);
+    if (t.distances[destination] == INF) return {};
+    return extract_shortest_path(t.distances, t.previous, destination);
+}
+
+const vector<int>& ShortestPathCache::distances(int source)
+{
+    return tree(source).distances;
+}
+
+ShortestPathCache::Tree& ShortestPathCache::tree(int source)
+{
+    check_vertex(source);
+    auto it = trees.find(source);
+    if (it != trees.end()) {
+        lru.splice(lru.begin(), lru, it->second.lru_position);
+        return it->second;
+    }
+
+    if (static_cast<int>(trees.size()) >= capacity) {
+        trees.erase(lru.back());
+        lru.pop_back();
+    }
+    lru.push_front(source);
+    Tree& t = trees[source];
+    t.lru_position = lru.begin();
+    t.distances = dijkstra_shortest_path<FourAryHeap>(out, source, t.previous);
+    return t;
+}
+
+// u -> v got cheaper (or appeared): only vertices it improves change.
+void ShortestPathCache::edge_decreased(Tree& t, int u, int v, int weight)
+{
+    if (t.distances[u] == INF || t.distances[u] + weight >= t.distances[v]) return;
+    t.distances[v] = t.distances[u] + weight;
+    t.previous[v] = u;
+    pq.push(v, t.distances[v]);
+    propagate(t);
+}
+
+// u -> v got dearer (or vanished): only the subtree below v can change, and
+// only if the tree reached v through u and no other u -> v edge is as cheap.
+void ShortestPathCache::edge_increased(Tree& t, int u, int v)
+{
+    if (t.previous[v] != u) return;
+    for (const Edge& e : out[u])
+        if (e.dst == v && t.distances[u] + e.weight == t.distances[v]) return;
+
+    // collect the subtree rooted at v and forget its distances
+    subtree.assign(1, v);
+    in_subtree[v] = true;
+    for (size_t i = 0; i < subtree.size(); ++i) {
+        int x = subtree[i];
+        for (const Edge& e : out[x]) {
+            if (!in_subtree[e.dst] && t.previous[e.dst] == x) {
+                in_subtree[e.dst] = true;
+                subtree.push_back(e.dst);
+            }
+        }
+    }
+    for (int x : subtree) {
+        t.distances[x] = INF;
+        t.previous[x] = -1;
+    }
+
+    // best way back in from the unaffected part of the tree, then Dijkstra inside
+    for (int x : subtree) {
+        for (const Edge& e : in[x]) {
+            int p = e.src;
+            if (!in_subtree[p] && t.distances[p] != INF && t.distances[p] + e.weight < t.distances[x]) {
+                t.distances[x] = t.distances[p] + e.weight;
+                t.previous[x] = p;
+            }
+        }
+        if (t.distances[x] != INF) pq.push(x, t.distances[x]);
+    }
+    for (int x : subtree) in_subtree[x] = false;
+    propagate(t);
+}
+
+// Dijkstra from the queued vertices; vertices outside the repaired region
+// are already optimal, so the relaxation test leaves them alone.
+void ShortestPathCache::propagate(Tree& t)
+{
+    while (!pq.empty()) {
+        int x = pq.pop();
+        for (const Edge& e : out[x]) {
+            int d = t.distances[x] + e.weight;
+            if (d < t.distances[e.dst]) {
+                t.distances[e.dst] = d;
+                t.previous[e.dst] = x;
+                pq.push(e.dst, d);
+            }
+        }
+    }
+}
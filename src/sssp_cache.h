@@ -0,0 +1,53 @@
+#pragma once
+
+#include "dijkstra_heaps.h"
+#include <list>
+#include <unordered_map>
+
+// Shortest-path trees for the most recently queried sources over a graph
+// whose edges change. Every edge update repairs each cached tree in place:
+// a cheaper edge re-relaxes only the vertices it improves, and a dearer or
+// deleted tree edge recomputes only the subtree that hung below it.
+// Weights must stay non-negative; negative ones throw runtime_error.
+class ShortestPathCache {
+public:
+    ShortestPathCache(const Graph& G, int capacity);
+
+    // With parallel edges, (u, v) names the first u -> v edge in input order.
+    void insert_edge(int u, int v, int weight);
+    void remove_edge(int u, int v);
+    void set_edge_weight(int u, int v, int weight);
+
+    // A miss computes the source's tree and evicts the least recently used one.
+    int distance(int source, int destination);
+    vector<int> path(int source, int destination); // empty if unreachable
+    const vector<int>& distances(int source);      // valid until the next query or update
+
+    int cached_sources() const { return trees.size(); }
+
+private:
+    struct Tree {
+        vector<int> distances;
+        vector<int> previous;
+        list<int>::iterator lru_position;
+    };
+
+    Tree& tree(int source);
+    void check_vertex(int v) const;
+    void check_weight(int weight) const;
+    Edge& find_edge(int u, int v);
+    void edge_decreased(Tree& t, int u, int v, int weight);
+    void edge_increased(Tree& t, int u, int v);
+    void propagate(Tree& t);
+
+    Graph out;  // out[u]: edges leaving u
+    Graph in;   // in[v]: edges entering v
+    int capacity;
+    list<int> lru; // sources, most recent first
+    unordered_map<int, Tree> trees;
+
+    // repair scratch, reused across updates
+    FourAryHeap pq;
+    vector<int> subtree;
+    vector<bool> in_subtree;
+};